@@ -0,0 +1,396 @@
+// python/plateverb_module.c
+// CPython bindings for the PlateVerb DSP core.
+//
+// Audio is passed through the buffer protocol (NumPy float32 arrays,
+// array('f'), memoryviews, ...) and processed in place with the GIL
+// released, so separate instances can run concurrently from a thread pool.
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <pythread.h>
+#include <string.h>
+
+#include "plateverb.h"
+
+typedef struct {
+  PyObject_HEAD
+  PlateVerb* pv;
+  PyThread_type_lock lock;  // one process() per instance at a time
+  double sample_rate;
+} PyPlateVerb;
+
+// ----- Buffer helpers -----
+static int get_float_buffer(PyObject* obj, Py_buffer* view, int writable, const char* name) {
+  const int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+  if (PyObject_GetBuffer(obj, view, flags) < 0) return -1;
+  const char* fmt = view->format ? view->format : "B";
+  if (fmt[0] == '<' || fmt[0] == '=' || fmt[0] == '@') fmt++;
+  if (view->itemsize != (Py_ssize_t)sizeof(float) || strcmp(fmt, "f") != 0) {
+    PyErr_Format(PyExc_TypeError, "%s must be a float32 buffer", name);
+    PyBuffer_Release(view);
+    return -1;
+  }
+  return 0;
+}
+
+static int check_ready(PyPlateVerb* self) {
+  if (self->pv) return 0;
+  PyErr_SetString(PyExc_RuntimeError, "PlateVerb is not initialized");
+  return -1;
+}
+
+// Port of a control symbol; output ports are not controls
+static int control_port(const char* symbol) {
+  const int port = plateverb_port_index(symbol);
+  if (port < PLATEVERB_MIX || port >= PLATEVERB_LATENCY) {
+    PyErr_Format(PyExc_KeyError, "unknown control '%s'", symbol);
+    return -1;
+  }
+  return port;
+}
+
+// Parse every value first, then apply them under the instance lock, since
+// process() may be running on another thread
+static int set_params(PyPlateVerb* self, PyObject* kwargs) {
+  PyObject* key;
+  PyObject* value;
+  Py_ssize_t pos = 0;
+  int ports[PLATEVERB_NUM_PORTS];
+  float values[PLATEVERB_NUM_PORTS];
+  int n = 0;
+  if (!kwargs) return 0;
+  while (PyDict_Next(kwargs, &pos, &key, &value)) {
+    const char* symbol = PyUnicode_AsUTF8(key);
+    if (!symbol) return -1;
+    const int port = control_port(symbol);
+    if (port < 0) return -1;
+    const double v = PyFloat_AsDouble(value);
+    if (v == -1.0 && PyErr_Occurred()) return -1;
+    ports[n] = port;              // keys are distinct controls: n stays in range
+    values[n++] = (float)v;
+  }
+  Py_BEGIN_ALLOW_THREADS
+  PyThread_acquire_lock(self->lock, WAIT_LOCK);
+  for (int i = 0; i < n; ++i) plateverb_set(self->pv, ports[i], values[i]);
+  PyThread_release_lock(self->lock);
+  Py_END_ALLOW_THREADS
+  return 0;
+}
+
+// ----- PlateVerb type -----
+static int PyPlateVerb_init(PyPlateVerb* self, PyObject* args, PyObject* kwargs) {
+  double rate = 48000.0;
+  if (!PyArg_ParseTuple(args, "|d", &rate)) return -1;
+  if (rate <= 0.0) {
+    PyErr_SetString(PyExc_ValueError, "sample_rate must be positive");
+    return -1;
+  }
+  // process() and process_multi() use self->pv without the GIL, so the
+  // instance is never swapped under them: a second __init__ is refused
+  if (self->pv) {
+    PyErr_SetString(PyExc_RuntimeError, "PlateVerb is already initialized");
+    return -1;
+  }
+  self->pv = plateverb_new(rate);
+  if (!self->pv) {
+    PyErr_NoMemory();
+    return -1;
+  }
+  if (!self->lock) {
+    self->lock = PyThread_allocate_lock();
+    if (!self->lock) {
+      PyErr_NoMemory();
+      return -1;
+    }
+  }
+  self->sample_rate = rate;
+  return set_params(self, kwargs);
+}
+
+static void PyPlateVerb_dealloc(PyPlateVerb* self) {
+  if (self->pv) plateverb_free(self->pv);
+  if (self->lock) PyThread_free_lock(self->lock);
+  Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* PyPlateVerb_process(PyPlateVerb* self, PyObject* args) {
+  PyObject *in_obj, *l_obj, *r_obj;
+  Py_buffer in, l, r;
+  if (check_ready(self) < 0) return NULL;
+  if (!PyArg_ParseTuple(args, "OOO:process", &in_obj, &l_obj, &r_obj)) return NULL;
+  if (get_float_buffer(in_obj, &in, 0, "input") < 0) return NULL;
+  if (get_float_buffer(l_obj, &l, 1, "out_l") < 0) {
+    PyBuffer_Release(&in);
+    return NULL;
+  }
+  if (get_float_buffer(r_obj, &r, 1, "out_r") < 0) {
+    PyBuffer_Release(&in);
+    PyBuffer_Release(&l);
+    return NULL;
+  }
+
+  PyObject* result = NULL;
+  const Py_ssize_t n = in.len / (Py_ssize_t)sizeof(float);
+  if (l.len != in.len || r.len != in.len) {
+    PyErr_SetString(PyExc_ValueError, "input and outputs must have the same length");
+  } else if ((size_t)n > UINT32_MAX) {
+    PyErr_SetString(PyExc_OverflowError, "buffer too long");
+  } else {
+    Py_BEGIN_ALLOW_THREADS
+    PyThread_acquire_lock(self->lock, WAIT_LOCK);
+    plateverb_process(self->pv, (const float*)in.buf, (float*)l.buf, (float*)r.buf, (uint32_t)n);
+    PyThread_release_lock(self->lock);
+    Py_END_ALLOW_THREADS
+    Py_INCREF(Py_None);
+    result = Py_None;
+  }
+
+  PyBuffer_Release(&in);
+  PyBuffer_Release(&l);
+  PyBuffer_Release(&r);
+  return result;
+}
+
+static PyObject* PyPlateVerb_reset(PyPlateVerb* self, PyObject* unused) {
+  if (check_ready(self) < 0) return NULL;
+  Py_BEGIN_ALLOW_THREADS
+  PyThread_acquire_lock(self->lock, WAIT_LOCK);
+  plateverb_reset(self->pv);
+  PyThread_release_lock(self->lock);
+  Py_END_ALLOW_THREADS
+  Py_RETURN_NONE;
+}
+
+static PyObject* PyPlateVerb_set(PyPlateVerb* self, PyObject* args, PyObject* kwargs) {
+  if (PyTuple_GET_SIZE(args) != 0) {
+    PyErr_SetString(PyExc_TypeError, "set() takes keyword arguments only");
+    return NULL;
+  }
+  if (check_ready(self) < 0 || set_params(self, kwargs) < 0) return NULL;
+  Py_RETURN_NONE;
+}
+
+static PyObject* PyPlateVerb_get(PyPlateVerb* self, PyObject* arg) {
+  if (check_ready(self) < 0) return NULL;
+  const char* symbol = PyUnicode_AsUTF8(arg);
+  if (!symbol) return NULL;
+  const int port = control_port(symbol);
+  if (port < 0) return NULL;
+  float v;
+  Py_BEGIN_ALLOW_THREADS
+  PyThread_acquire_lock(self->lock, WAIT_LOCK);
+  v = plateverb_get(self->pv, port);
+  PyThread_release_lock(self->lock);
+  Py_END_ALLOW_THREADS
+  return PyFloat_FromDouble(v);
+}
+
+static PyObject* PyPlateVerb_get_sample_rate(PyPlateVerb* self, void* closure) {
+  return PyFloat_FromDouble(self->sample_rate);
+}
+
+static PyObject* PyPlateVerb_get_tail_seconds(PyPlateVerb* self, void* closure) {
+  if (check_ready(self) < 0) return NULL;
+  float tail;
+  Py_BEGIN_ALLOW_THREADS
+  PyThread_acquire_lock(self->lock, WAIT_LOCK);
+  tail = plateverb_tail_seconds(self->pv);
+  PyThread_release_lock(self->lock);
+  Py_END_ALLOW_THREADS
+  return PyFloat_FromDouble(tail);
+}
+
+static PyMethodDef PyPlateVerb_methods[] = {
+  { "process", (PyCFunction)PyPlateVerb_process, METH_VARARGS,
+    "process(input, out_l, out_r)\n\n"
+    "Render mono float32 `input` into the float32 `out_l`/`out_r` buffers.\n"
+    "`input` may be the same buffer as one of the outputs. The GIL is\n"
+    "released while processing." },
+  { "reset", (PyCFunction)PyPlateVerb_reset, METH_NOARGS,
+    "Clear the reverb tail and all filter state." },
+  { "set", (PyCFunction)(void (*)(void))PyPlateVerb_set, METH_VARARGS | METH_KEYWORDS,
+    "set(**controls)\n\nSet controls by TTL symbol, e.g. set(mix=0.5, decay_rt60=4.0)." },
+  { "get", (PyCFunction)PyPlateVerb_get, METH_O,
+    "get(symbol) -> float" },
+  { NULL, NULL, 0, NULL }
+};
+
+static PyGetSetDef PyPlateVerb_getset[] = {
+  { "sample_rate", (getter)PyPlateVerb_get_sample_rate, NULL, "Sample rate in Hz", NULL },
+  { "tail_seconds", (getter)PyPlateVerb_get_tail_seconds, NULL,
+    "Estimated seconds until the output falls below -100 dBFS if the input\n"
+    "went silent now. Updated by process().", NULL },
+  { NULL, NULL, NULL, NULL, NULL }
+};
+
+static PyTypeObject PyPlateVerbType = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+  .tp_name = "plateverb.PlateVerb",
+  .tp_basicsize = sizeof(PyPlateVerb),
+  .tp_flags = Py_TPFLAGS_DEFAULT,
+  .tp_doc = "PlateVerb(sample_rate=48000.0, **controls)",
+  .tp_new = PyType_GenericNew,
+  .tp_init = (initproc)PyPlateVerb_init,
+  .tp_dealloc = (destructor)PyPlateVerb_dealloc,
+  .tp_methods = PyPlateVerb_methods,
+  .tp_getset = PyPlateVerb_getset,
+};
+
+// ----- Multi-preset rendering -----
+static int overlaps(const Py_buffer* a, const Py_buffer* b) {
+  const uintptr_t a0 = (uintptr_t)a->buf, b0 = (uintptr_t)b->buf;
+  return a->len > 0 && b->len > 0 && a0 < b0 + (uintptr_t)b->len && b0 < a0 + (uintptr_t)a->len;
+}
+
+static int cmp_ptr(const void* a, const void* b) {
+  const uintptr_t pa = (uintptr_t)*(void* const*)a;
+  const uintptr_t pb = (uintptr_t)*(void* const*)b;
+  return (pa > pb) - (pa < pb);
+}
+
+static PyObject* plateverb_process_multi_py(PyObject* module, PyObject* args) {
+  PyObject *inst_obj, *in_obj, *l_obj, *r_obj;
+  if (!PyArg_ParseTuple(args, "OOOO:process_multi", &inst_obj, &in_obj, &l_obj, &r_obj)) return NULL;
+
+  PyObject* insts = PySequence_Fast(inst_obj, "instances must be a sequence");
+  PyObject* ls = insts ? PySequence_Fast(l_obj, "outs_l must be a sequence") : NULL;
+  PyObject* rs = ls ? PySequence_Fast(r_obj, "outs_r must be a sequence") : NULL;
+  if (!rs) {
+    Py_XDECREF(insts);
+    Py_XDECREF(ls);
+    return NULL;
+  }
+
+  PyObject* result = NULL;
+  const Py_ssize_t count = PySequence_Fast_GET_SIZE(insts);
+  Py_ssize_t n = 0;
+  Py_ssize_t acquired = 0;
+  int have_in = 0;
+  Py_buffer in;
+  Py_buffer* views = NULL;          // out_l views, then out_r views
+  float** outs = NULL;              // same layout as views
+  PlateVerb** pvs = NULL;
+  PyThread_type_lock* locks = NULL;
+
+  if (PySequence_Fast_GET_SIZE(ls) != count || PySequence_Fast_GET_SIZE(rs) != count) {
+    PyErr_SetString(PyExc_ValueError, "need one out_l and one out_r buffer per instance");
+    goto done;
+  }
+  if (get_float_buffer(in_obj, &in, 0, "input") < 0) goto done;
+  have_in = 1;
+  n = in.len / (Py_ssize_t)sizeof(float);
+  if ((size_t)n > UINT32_MAX) {
+    PyErr_SetString(PyExc_OverflowError, "buffer too long");
+    goto done;
+  }
+
+  views = PyMem_Calloc((size_t)count * 2 + 1, sizeof(Py_buffer));
+  outs = PyMem_Calloc((size_t)count * 2 + 1, sizeof(float*));
+  pvs = PyMem_Calloc((size_t)count + 1, sizeof(PlateVerb*));
+  locks = PyMem_Calloc((size_t)count + 1, sizeof(PyThread_type_lock));
+  if (!views || !outs || !pvs || !locks) {
+    PyErr_NoMemory();
+    goto done;
+  }
+
+  for (Py_ssize_t k = 0; k < count; ++k) {
+    PyObject* o = PySequence_Fast_GET_ITEM(insts, k);
+    if (!PyObject_TypeCheck(o, &PyPlateVerbType)) {
+      PyErr_SetString(PyExc_TypeError, "instances must be PlateVerb objects");
+      goto done;
+    }
+    if (check_ready((PyPlateVerb*)o) < 0) goto done;
+    pvs[k] = ((PyPlateVerb*)o)->pv;
+    locks[k] = ((PyPlateVerb*)o)->lock;
+
+    Py_buffer* vl = &views[k];
+    Py_buffer* vr = &views[count + k];
+    if (get_float_buffer(PySequence_Fast_GET_ITEM(ls, k), vl, 1, "out_l") < 0) goto done;
+    if (get_float_buffer(PySequence_Fast_GET_ITEM(rs, k), vr, 1, "out_r") < 0) goto done;
+    if (vl->len != in.len || vr->len != in.len) {
+      PyErr_SetString(PyExc_ValueError, "input and outputs must have the same length");
+      goto done;
+    }
+    if (overlaps(vl, &in) || overlaps(vr, &in)) {
+      PyErr_SetString(PyExc_ValueError, "outputs must not share memory with the input");
+      goto done;
+    }
+    outs[k] = (float*)vl->buf;
+    outs[count + k] = (float*)vr->buf;
+  }
+
+  // Lock in address order so concurrent calls over overlapping sets cannot deadlock
+  qsort(locks, (size_t)count, sizeof(PyThread_type_lock), cmp_ptr);
+  for (Py_ssize_t k = 1; k < count; ++k) {
+    if (locks[k] == locks[k - 1]) {
+      PyErr_SetString(PyExc_ValueError, "an instance appears more than once");
+      goto done;
+    }
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  for (acquired = 0; acquired < count; ++acquired) PyThread_acquire_lock(locks[acquired], WAIT_LOCK);
+  plateverb_process_multi(pvs, (uint32_t)count, (const float*)in.buf, outs, outs + count, (uint32_t)n);
+  Py_END_ALLOW_THREADS
+  Py_INCREF(Py_None);
+  result = Py_None;
+
+done:
+  while (acquired > 0) PyThread_release_lock(locks[--acquired]);
+  if (views) {
+    for (Py_ssize_t k = 0; k < count * 2; ++k) {
+      if (views[k].obj) PyBuffer_Release(&views[k]);
+    }
+  }
+  if (have_in) PyBuffer_Release(&in);
+  PyMem_Free(views);
+  PyMem_Free(outs);
+  PyMem_Free(pvs);
+  PyMem_Free(locks);
+  Py_DECREF(insts);
+  Py_DECREF(ls);
+  Py_DECREF(rs);
+  return result;
+}
+
+static PyMethodDef plateverb_functions[] = {
+  { "process_multi", plateverb_process_multi_py, METH_VARARGS,
+    "process_multi(instances, input, outs_l, outs_r)\n\n"
+    "Render one float32 input through several PlateVerb instances (preset\n"
+    "variations) in one pass. Instances with equal predelay_ms, locut and\n"
+    "grit share the input stage. Reset the instances before the first call." },
+  { NULL, NULL, 0, NULL }
+};
+
+static struct PyModuleDef plateverb_module = {
+  PyModuleDef_HEAD_INIT,
+  .m_name = "plateverb",
+  .m_doc = "LilBrimstone PlateVerb DSP core",
+  .m_size = -1,
+  .m_methods = plateverb_functions,
+};
+
+PyMODINIT_FUNC PyInit_plateverb(void) {
+  if (PyType_Ready(&PyPlateVerbType) < 0) return NULL;
+  PyObject* m = PyModule_Create(&plateverb_module);
+  if (!m) return NULL;
+  Py_INCREF(&PyPlateVerbType);
+  if (PyModule_AddObject(m, "PlateVerb", (PyObject*)&PyPlateVerbType) < 0) {
+    Py_DECREF(&PyPlateVerbType);
+    Py_DECREF(m);
+    return NULL;
+  }
+  PyObject* controls = PyTuple_New(PLATEVERB_LATENCY - PLATEVERB_MIX);
+  if (!controls) {
+    Py_DECREF(m);
+    return NULL;
+  }
+  for (int p = PLATEVERB_MIX; p < PLATEVERB_LATENCY; ++p) {
+    PyTuple_SET_ITEM(controls, p - PLATEVERB_MIX, PyUnicode_FromString(plateverb_port_symbol(p)));
+  }
+  if (PyModule_AddObject(m, "CONTROLS", controls) < 0) {
+    Py_DECREF(controls);
+    Py_DECREF(m);
+    return NULL;
+  }
+  return m;
+}
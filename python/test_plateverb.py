@@ -0,0 +1,111 @@
+# python/test_plateverb.py
+# Smoke test for the CPython bindings: make check-python (or run this file
+# with the built module on PYTHONPATH). Standard library only.
+import array
+import math
+import unittest
+
+import plateverb
+
+RATE = 48000.0
+N = 4800
+
+
+def burst(n=N, length=N // 8):
+    # A deterministic noise burst followed by silence
+    x = array.array('f', bytes(4 * n))
+    s = 1
+    for i in range(length):
+        s = (s * 1664525 + 1013904223) & 0xffffffff
+        x[i] = (s / 4294967296.0 - 0.5) * 0.8
+    return x
+
+
+def zeros(n=N):
+    return array.array('f', bytes(4 * n))
+
+
+def render(pv, x):
+    l, r = zeros(len(x)), zeros(len(x))
+    pv.process(x, l, r)
+    return l, r
+
+
+class PlateVerbTest(unittest.TestCase):
+    def test_process(self):
+        pv = plateverb.PlateVerb(RATE, mix=1.0)
+        l, r = render(pv, burst())
+        self.assertTrue(all(math.isfinite(v) for v in l + r))
+        self.assertGreater(max(abs(v) for v in l[N // 2:]), 0.0)
+        self.assertGreater(pv.tail_seconds, 0.0)
+
+    def test_in_place(self):
+        x = burst()
+        a = plateverb.PlateVerb(RATE)
+        b = plateverb.PlateVerb(RATE)
+        l, r = render(a, x)
+        y = array.array('f', x)
+        r2 = zeros()
+        b.process(y, y, r2)
+        self.assertEqual(y, l)
+        self.assertEqual(r2, r)
+
+    def test_reset(self):
+        pv = plateverb.PlateVerb(RATE, decay_rt60=4.0)
+        first = render(pv, burst())
+        render(pv, burst())
+        pv.reset()
+        self.assertEqual(render(pv, burst()), first)
+
+    def test_no_reinit(self):
+        pv = plateverb.PlateVerb(RATE)
+        with self.assertRaises(RuntimeError):
+            pv.__init__(RATE)
+        render(pv, burst())
+
+    def test_set_get(self):
+        pv = plateverb.PlateVerb(RATE)
+        pv.set(mix=0.5, decay_rt60=4.0)
+        self.assertEqual(pv.get('mix'), 0.5)
+        self.assertEqual(pv.get('decay_rt60'), 4.0)
+        self.assertNotIn('latency', plateverb.CONTROLS)
+        self.assertNotIn('tail', plateverb.CONTROLS)
+        with self.assertRaises(KeyError):
+            pv.set(tail=5.0)
+        with self.assertRaises(KeyError):
+            pv.get('latency')
+        with self.assertRaises(KeyError):
+            pv.set(nonsense=1.0)
+        with self.assertRaises(TypeError):
+            pv.set(0.5)
+
+    def test_process_multi(self):
+        x = burst(length=N)
+        presets = [dict(mix=1.0, decay_rt60=2.0), dict(mix=0.5, size=2.0),
+                   dict(mix=1.0, predelay_ms=5.0), dict(mix=1.0, locut=200.0, grit=0.3)]
+        insts = [plateverb.PlateVerb(RATE, **p) for p in presets]
+        refs = [plateverb.PlateVerb(RATE, **p) for p in presets]
+        # Several calls of host-sized blocks, then each instance on its own:
+        # followers must have kept their input stage in step
+        for off in range(0, N, 256):
+            block = x[off:off + 256]
+            outs_l = [zeros(len(block)) for _ in presets]
+            outs_r = [zeros(len(block)) for _ in presets]
+            plateverb.process_multi(insts, block, outs_l, outs_r)
+            for p, ref, l, r in zip(presets, refs, outs_l, outs_r):
+                self.assertEqual(render(ref, block), (l, r), p)
+        for p, pv, ref in zip(presets, insts, refs):
+            self.assertEqual(render(pv, x), render(ref, x), p)
+
+    def test_process_multi_rejects_alias(self):
+        x = burst()
+        insts = [plateverb.PlateVerb(RATE)]
+        with self.assertRaises(ValueError):
+            plateverb.process_multi(insts, x, [x], [zeros()])
+        view = memoryview(x)
+        with self.assertRaises(ValueError):
+            plateverb.process_multi(insts, view[:N // 2], [zeros(N // 2)], [view[N // 4:N // 4 + N // 2]])
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -1,9 +1,28 @@
 // src/plateverb.c
+#ifdef PLATEVERB_PARALLEL
+#define _GNU_SOURCE               // worker affinity (Linux)
+#endif
+#define _POSIX_C_SOURCE 200809L   // clock_gettime, sysconf
+
 #include <lv2/core/lv2.h>
+#include <lv2/worker/worker.h>
+#include <float.h>
 #include <math.h>
+#include <stdatomic.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#ifdef PLATEVERB_PARALLEL
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <unistd.h>
+#endif
+
+#include "plateverb.h"
+#include "topology.h"
 
 #ifndef LV2_SYMBOL_EXPORT
 #define LV2_SYMBOL_EXPORT __attribute__((visibility("default")))
@@ -11,21 +30,121 @@
 
 #define PLATEVERB_URI "https://github.com/lilbrimstone/plateverb"
 
+// Stage functions are expanded into each run variant (see run_chunks)
+#define FORCE_INLINE inline __attribute__((always_inline))
+
 // ----- Utilities -----
 static inline float clampf(float x, float lo, float hi) {
   return (x < lo) ? lo : (x > hi) ? hi : x;
 }
 
+static inline float minf(float a, float b) {
+  return (a < b) ? a : b;
+}
+
 static inline float maxf(float a, float b) {
   return (a > b) ? a : b;
 }
 
+// ----- Portable Math -----
+// With PLATEVERB_DETERMINISTIC the DSP uses its own sin/cos/exp/log/tanh, built
+// from IEEE single-precision +, -, *, / and floorf in a fixed order, so
+// every libm, compiler and architecture produces the same bits. Build with
+// -ffp-contract=off (the Makefile does) so no multiply-add is fused.
+// Otherwise these are plain libm calls.
+#ifdef PLATEVERB_DETERMINISTIC
+#if FLT_EVAL_METHOD != 0
+#error "PLATEVERB_DETERMINISTIC needs float evaluated in float (SSE/NEON, not x87)"
+#endif
+
+// Cody-Waite reduction by pi/4 and minimax polynomials (Cephes sinf/cosf),
+// accurate to about 1 ulp for |x| < 8192.
+static inline void dsp_sincosf(float x, float* s, float* c) {
+  const float ax = fabsf(x);
+  int j = (int)(ax * 1.27323954473516f);
+  j += j & 1;
+  const float fj = (float)j;
+  const float r = ((ax - fj * 0.78515625f) - fj * 2.4187564849853515625e-4f) - fj * 3.77489497744594108e-8f;
+  const float z = r * r;
+  const float ps = ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * r + r;
+  const float pc = ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z
+                 - 0.5f * z + 1.0f;
+  const int q = j & 7;
+  const float sv = (q == 2 || q == 6) ? pc : ps;
+  const float cv = (q == 2 || q == 6) ? ps : pc;
+  const int s_neg = (q >= 4) != (x < 0.0f);
+  const int c_neg = (q == 2 || q == 4);
+  *s = s_neg ? -sv : sv;
+  *c = c_neg ? -cv : cv;
+}
+
+static inline float dsp_sinf(float x) { float s, c; dsp_sincosf(x, &s, &c); return s; }
+static inline float dsp_cosf(float x) { float s, c; dsp_sincosf(x, &s, &c); return c; }
+
+// exp(x) = 2^n * exp(r), |r| <= ln2/2 (Cephes expf)
+static inline float dsp_expf(float x) {
+  if (x > 88.0f) x = 88.0f;
+  if (x < -87.0f) return 0.0f;
+  const float n = floorf(x * 1.44269504088896341f + 0.5f);
+  const float r = (x - n * 0.693359375f) - n * -2.12194440e-4f;
+  const float z = r * r;
+  const float p = (((((1.9875691500e-4f * r + 1.3981999507e-3f) * r + 8.3334519073e-3f) * r
+                 + 4.1665795894e-2f) * r + 1.6666665459e-1f) * r + 5.0000001201e-1f) * z + r + 1.0f;
+  union { uint32_t u; float f; } scale = { (uint32_t)((int)n + 127) << 23 };
+  return p * scale.f;
+}
+
+static inline float dsp_exp10f(float x) { return dsp_expf(x * 2.30258509299404568f); }
+
+// log10(x) for finite x > 0: frexpf split, natural log polynomial on
+// [sqrt(1/2), sqrt(2)) (Cephes logf), then scaled
+static inline float dsp_log10f(float x) {
+  int e;
+  float m = frexpf(x, &e);
+  if (m < 0.707106781186547524f) {
+    m = m + m;
+    e -= 1;
+  }
+  m = m - 1.0f;
+  const float z = m * m;
+  float y = ((((((((7.0376836292e-2f * m - 1.1514610310e-1f) * m + 1.1676998740e-1f) * m
+          - 1.2420140846e-1f) * m + 1.4249322787e-1f) * m - 1.6668057665e-1f) * m
+          + 2.0000714765e-1f) * m - 2.4999993993e-1f) * m + 3.3333331174e-1f) * m * z;
+  y = y + (float)e * -2.12194440e-4f;
+  y = y - 0.5f * z;
+  return ((m + y) + (float)e * 0.693359375f) * 0.434294481903251828f;
+}
+
+// Odd polynomial near zero (Cephes tanhf), 1 - 2/(e^2x + 1) elsewhere
+static inline float dsp_tanhf(float x) {
+  const float ax = fabsf(x);
+  float y;
+  if (ax >= 9.0f) {
+    y = 1.0f;
+  } else if (ax >= 0.625f) {
+    y = 1.0f - 2.0f / (dsp_expf(2.0f * ax) + 1.0f);
+  } else {
+    const float z = ax * ax;
+    y = ((((-5.70498872745e-3f * z + 2.06390887954e-2f) * z - 5.37397155531e-2f) * z
+        + 1.33314422036e-1f) * z - 3.33332819422e-1f) * z * ax + ax;
+  }
+  return (x < 0.0f) ? -y : y;
+}
+#else
+static inline float dsp_sinf(float x) { return sinf(x); }
+static inline float dsp_cosf(float x) { return cosf(x); }
+static inline float dsp_expf(float x) { return expf(x); }
+static inline float dsp_exp10f(float x) { return powf(10.0f, x); }
+static inline float dsp_log10f(float x) { return log10f(x); }
+static inline float dsp_tanhf(float x) { return tanhf(x); }
+#endif
+
 // Fast Soft Clipper (tanh approximation)
 // y = x * (27 + x*x) / (27 + 9*x*x) is a common fast approx, 
 // but standard tanhf is usually optimized enough on ARM.
 static inline float soft_clip(float x) {
     // Input gain boost happens before this function
-    return tanhf(x);
+    return dsp_tanhf(x);
 }
 
 // ----- One-pole lowpass -----
@@ -45,6 +164,45 @@ static inline float lp_process(OnePoleLP* lp, float x) {
   return y;
 }
 
+// ----- Block First-Order IIR -----
+// y[n] = u[n] + a * y[n-1] over a whole block. Each group of four samples
+// is solved as a parallel prefix (two lane-wise scan steps with a and a^2),
+// then the previous group's last output is carried in with a^1..a^4. The
+// only serial dependency left is one multiply-add per four samples.
+typedef struct {
+  float pw[4];   // a, a^2, a^3, a^4
+} IIR1Coefs;
+
+static inline void iir1_set(IIR1Coefs* c, float a) {
+  if (c->pw[0] == a) return;   // powers only change with the coefficient
+  c->pw[0] = a;
+  c->pw[1] = a * a;
+  c->pw[2] = c->pw[1] * a;
+  c->pw[3] = c->pw[1] * c->pw[1];
+}
+
+// `u` and `y` may be the same buffer. `state` is y[-1] in, y[n-1] out.
+static void iir1_block(const IIR1Coefs* c, const float* u, float* y, uint32_t n, float* state) {
+  const float a = c->pw[0], a2 = c->pw[1];
+  float s = *state;
+  uint32_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const float v0 = u[i], v1 = u[i + 1], v2 = u[i + 2], v3 = u[i + 3];
+    const float w1 = v1 + a * v0, w2 = v2 + a * v1, w3 = v3 + a * v2;   // distance 1
+    const float x2 = w2 + a2 * v0, x3 = w3 + a2 * w1;                    // distance 2
+    y[i]     = v0 + c->pw[0] * s;
+    y[i + 1] = w1 + c->pw[1] * s;
+    y[i + 2] = x2 + c->pw[2] * s;
+    y[i + 3] = x3 + c->pw[3] * s;
+    s = y[i + 3];
+  }
+  for (; i < n; ++i) {
+    s = u[i] + a * s;
+    y[i] = s;
+  }
+  *state = s;
+}
+
 // ----- Circular Delay -----
 typedef struct {
   float* buf;
@@ -52,17 +210,10 @@ typedef struct {
   int idx; 
 } Delay;
 
-static inline void delay_init(Delay* d, int size) {
-  if (size < 8) size = 8;
-  d->buf = (float*)calloc((size_t)size, sizeof(float));
-  d->size = d->buf ? size : 0;
-  d->idx = 0;
-}
-
-static inline void delay_free(Delay* d) {
-  free(d->buf);
-  d->buf = NULL;
-  d->size = 0;
+// Buffers live in the instance's TankArena; the Delay does not own them.
+static inline void delay_init(Delay* d, float* buf, int size) {
+  d->buf = buf;
+  d->size = size;
   d->idx = 0;
 }
 
@@ -90,6 +241,25 @@ static inline void delay_write(Delay* d, float x) {
   if (d->idx >= d->size) d->idx = 0;
 }
 
+// Copy n consecutive slots starting `back` behind the write index (at most
+// two runs of the ring). Reading with back >= n before a block is written is
+// the block form of delay_read(tap = back) for each sample of that block.
+static inline void delay_read_block(const Delay* d, int back, float* out, uint32_t n) {
+  int start = d->idx - back;
+  while (start < 0) start += d->size;
+  const uint32_t first = ((uint32_t)(d->size - start) < n) ? (uint32_t)(d->size - start) : n;
+  memcpy(out, d->buf + start, first * sizeof(float));
+  memcpy(out + first, d->buf, (n - first) * sizeof(float));
+}
+
+static inline void delay_write_block(Delay* d, const float* x, uint32_t n) {
+  const uint32_t first = ((uint32_t)(d->size - d->idx) < n) ? (uint32_t)(d->size - d->idx) : n;
+  memcpy(d->buf + d->idx, x, first * sizeof(float));
+  memcpy(d->buf, x + first, (n - first) * sizeof(float));
+  d->idx += (int)n;
+  if (d->idx >= d->size) d->idx -= d->size;
+}
+
 // ----- Combs -----
 typedef struct {
   Delay delay;
@@ -98,8 +268,8 @@ typedef struct {
   int   D;         
 } Comb;
 
-static inline void comb_init(Comb* c, int max_delay, int D_init, float fb, float lp_a) {
-  delay_init(&c->delay, max_delay);
+static inline void comb_init(Comb* c, float* buf, int max_delay, int D_init, float fb, float lp_a) {
+  delay_init(&c->delay, buf, max_delay);
   lp_init(&c->lp, lp_a);
   c->feedback = fb;
   c->D = (D_init > 1) ? D_init : 1;
@@ -112,7 +282,14 @@ static inline float comb_process(Comb* c, float x, float fb_scale) {
   return y;
 }
 
-static inline void comb_free(Comb* c) { delay_free(&c->delay); }
+// comb_process() reading w of its tap and 1 - w of the tap `from`
+static inline float comb_process_xfade(Comb* c, float x, float fb_scale, int from, float w) {
+  const float y0 = delay_read(&c->delay, from);
+  const float y = y0 + w * (delay_read(&c->delay, c->D) - y0);
+  const float damped = lp_process(&c->lp, y);
+  delay_write(&c->delay, x + (c->feedback * fb_scale) * damped);
+  return y;
+}
 
 // ----- Allpass -----
 typedef struct {
@@ -121,8 +298,8 @@ typedef struct {
   int   D; 
 } Allpass;
 
-static inline void allpass_init(Allpass* ap, int max_delay, int D_init, float a) {
-  delay_init(&ap->delay, max_delay);
+static inline void allpass_init(Allpass* ap, float* buf, int max_delay, int D_init, float a) {
+  delay_init(&ap->delay, buf, max_delay);
   ap->a = a;
   ap->D = (D_init > 1) ? D_init : 1;
 }
@@ -135,14 +312,185 @@ static inline float allpass_process(Allpass* ap, float x) {
   return y;
 }
 
-static inline void allpass_free(Allpass* ap) { delay_free(&ap->delay); }
+// Allpass with a fractional (modulated) delay
+static inline float allpass_process_mod(Allpass* ap, float x, float tap) {
+  const float d = delay_read_linear(&ap->delay, tap);
+  const float y = d - ap->a * x;
+  const float u = x + ap->a * y;
+  delay_write(&ap->delay, u);
+  return y;
+}
+
+// ----- Block Modulated Allpass -----
+// Fill the fractional read position of each sample in the block from the
+// LFO and return the smallest integer tap.
+static inline int allpass_positions(const Allpass* ap, const float* lfo, float depth, float* pos, uint32_t n) {
+  const float hi = (float)ap->delay.size - 4.0f;
+  float lo = hi;
+  for (uint32_t k = 0; k < n; ++k) {
+    float d = (float)ap->D + lfo[k] * depth;
+    d = (d < 4.0f) ? 4.0f : (d > hi) ? hi : d;
+    pos[k] = d;
+    if (d < lo) lo = d;
+  }
+  return (int)lo;
+}
+
+// Move the positions from allpass_positions() part of the way back to the
+// tap `from`: all of it at the start of a crossfade, none at the end (w0 =
+// share already done, dw = share per sample). Returns the new smallest
+// integer tap.
+static inline int allpass_glide(const Allpass* ap, int from, float w0, float dw, float* pos, uint32_t n) {
+  const float hi = (float)ap->delay.size - 4.0f;
+  const float step = (float)(from - ap->D);
+  float lo = hi;
+  for (uint32_t k = 0; k < n; ++k) {
+    const float w = minf(w0 + (float)(k + 1) * dw, 1.0f);
+    float d = pos[k] + (1.0f - w) * step;
+    d = (d < 4.0f) ? 4.0f : (d > hi) ? hi : d;
+    pos[k] = d;
+    if (d < lo) lo = d;
+  }
+  return (int)lo;
+}
+
+// Run one allpass over a block in place. When every tap reaches back past
+// the block (min_tap >= n), no read depends on this block's writes: gather
+// and interpolate all reads first, then do the allpass update for the whole
+// block with no loop-carried dependency. Otherwise go sample by sample.
+// `v` is n floats of scratch.
+static void allpass_block(Allpass* ap, const float* pos, int min_tap, float* x, float* v, uint32_t n) {
+  Delay* d = &ap->delay;
+  const float a = ap->a;
+  if (min_tap < (int)n) {
+    for (uint32_t k = 0; k < n; ++k) x[k] = allpass_process_mod(ap, x[k], pos[k]);
+    return;
+  }
+
+  for (uint32_t k = 0; k < n; ++k) {
+    const int32_t i_int = (int32_t)pos[k];
+    const float frac = pos[k] - (float)i_int;
+    int32_t r1 = d->idx + (int32_t)k - i_int;
+    if (r1 < 0) r1 += d->size;
+    int32_t r2 = r1 - 1;
+    if (r2 < 0) r2 += d->size;
+    v[k] = d->buf[r1] + frac * (d->buf[r2] - d->buf[r1]);
+  }
+  for (uint32_t k = 0; k < n; ++k) {
+    const float y = v[k] - a * x[k];
+    v[k] = x[k] + a * y;
+    x[k] = y;
+  }
+  delay_write_block(d, v, n);
+}
+
+// Unmodulated allpass over a block in place, for the lite quality tier.
+static void allpass_block_fixed(Allpass* ap, float* x, float* v, uint32_t n) {
+  if (ap->D < (int)n) {
+    for (uint32_t k = 0; k < n; ++k) x[k] = allpass_process(ap, x[k]);
+    return;
+  }
+  delay_read_block(&ap->delay, ap->D, v, n);
+  for (uint32_t k = 0; k < n; ++k) {
+    const float y = v[k] - ap->a * x[k];
+    v[k] = x[k] + ap->a * y;
+    x[k] = y;
+  }
+  delay_write_block(&ap->delay, v, n);
+}
+
+// ----- Tank Arena Pool -----
+// Every delay line of an instance lives in one TankArena. cleanup() parks
+// its arena in a small process-wide pool and the next instantiate() at the
+// same sample rate (hence the same arena size) takes it back, so preset
+// changes on the S2400 skip the allocator and the page faults.
+#define ARENA_POOL_SLOTS 16
+
+typedef struct {
+  size_t n_floats;
+  float data[];
+} TankArena;
+
+static _Atomic(TankArena*) arena_pool[ARENA_POOL_SLOTS];
+
+static TankArena* arena_acquire(size_t n_floats) {
+  for (int i = 0; i < ARENA_POOL_SLOTS; ++i) {
+    // Take the slot before looking at it; another thread may free what it holds
+    TankArena* a = atomic_exchange_explicit(&arena_pool[i], NULL, memory_order_acquire);
+    if (!a) continue;
+    if (a->n_floats == n_floats) return a;
+    TankArena* empty = NULL;
+    if (!atomic_compare_exchange_strong_explicit(&arena_pool[i], &empty, a,
+                                                 memory_order_release, memory_order_relaxed)) {
+      free(a);
+    }
+  }
+  // Pool miss: write every page now rather than faulting in run()
+  TankArena* a = (TankArena*)malloc(sizeof(TankArena) + n_floats * sizeof(float));
+  if (!a) return NULL;
+  a->n_floats = n_floats;
+  memset(a->data, 0, n_floats * sizeof(float));
+  return a;
+}
+
+static void arena_release(TankArena* a) {
+  if (!a) return;
+  for (int i = 0; i < ARENA_POOL_SLOTS; ++i) {
+    TankArena* empty = NULL;
+    if (atomic_compare_exchange_strong_explicit(&arena_pool[i], &empty, a,
+                                                memory_order_release, memory_order_relaxed)) {
+      return;
+    }
+  }
+  free(a);
+}
+
+__attribute__((destructor)) static void arena_pool_drain(void) {
+  for (int i = 0; i < ARENA_POOL_SLOTS; ++i) {
+    free(atomic_exchange_explicit(&arena_pool[i], NULL, memory_order_acquire));
+  }
+}
 
 // ----- Reverb Core -----
-#define NUM_COMBS        4
-#define NUM_ALLPASSES    2
 #define MAX_MS(ms, fs)   ((int)((ms) * 0.001f * (fs)) + 4)
+#define BLOCK_LEN        128   // run() works through the host buffer in chunks
+#define SIZE_KNOB_MIN    0.25f
+#define SIZE_KNOB_MAX    3.0f
+#define MOD_MAX_MS       5.0f  // Mod Depth maximum; allpasses keep this much headroom
+#define ER_SPAN_MS       32.0f // last early-reflection tap at Size 1.0
+#define SILENCE_FLOOR    1e-5f // -100 dBFS
+
+// Processing quality, lowered by the CPU budget coordinator under load
+enum {
+  QUALITY_FULL = 0,
+  QUALITY_LITE,             // no early reflections, unmodulated allpasses
+  QUALITY_IDLE              // lite, and silent chunks bypass the tank
+};
+
+// Delay lines are sized for a Size tier, not for the whole Size range.
+// Moving to another tier reallocates through the LV2 Worker.
+#define NUM_SIZE_TIERS   3
+static const float size_tiers[NUM_SIZE_TIERS] = { 0.75f, 1.5f, SIZE_KNOB_MAX };
 
+#ifdef PLATEVERB_PARALLEL
+// One frame of audio handed to the parallel engine (see Parallel Engine)
 typedef struct {
+  atomic_int state;         // JOB_*
+  atomic_int queued;        // entries for this job in the queue, stale or not
+  sem_t done;               // posted when a JOB_WAITED job finishes
+  struct PlateVerb* owner;
+  const float* src;         // what the job runs: the frame buffers below,
+  float* dst_l;             // or the caller's buffers in
+  float* dst_r;             // plateverb_process_batch()
+  uint32_t n;
+  float in[PLATEVERB_PARALLEL];
+  float out_l[PLATEVERB_PARALLEL];
+  float out_r[PLATEVERB_PARALLEL];
+  float tail;               // tail estimate after this frame
+} ParallelJob;
+#endif
+
+struct PlateVerb {
   // Ports
   const float* in;
   float* out_l;
@@ -159,6 +507,9 @@ typedef struct {
   const float* p_locut;
   // NEW PORT
   const float* p_grit;      // 0..1
+  const float* p_early;     // 0..1
+  float* p_latency;         // output, samples
+  float* p_tail;            // output, seconds
 
   // State
   float sample_rate;
@@ -178,20 +529,78 @@ typedef struct {
   int baseApL[NUM_ALLPASSES];
   int baseApR[NUM_ALLPASSES];
 
-  int max_comb_len;
+  int max_comb_len;         // comb/allpass capacity of the current tier
   int max_ap_len;
   int max_predelay_len;
+  TankArena* arena;         // backing store for every Delay above
+
+  // Size tier reallocation (LV2 Worker)
+  const LV2_Worker_Schedule* schedule;   // NULL: no worker, largest tier is used
+  int tier;
+  int tier_pending;         // ALLOC request in flight
+  int tier_stale;           // lines were cleared while it was
+  TankArena* retired;       // old arena waiting to be handed to the worker
+  uint32_t tank_frames;     // samples written to every line so far (wraps)
+
+  // Tap crossfade after a tier swap (see tier_install)
+  int xfade_left;           // samples to go
+  int xfadeCombL[NUM_COMBS];   // taps before the swap
+  int xfadeCombR[NUM_COMBS];
+  int xfadeApL[NUM_ALLPASSES];
+  int xfadeApR[NUM_ALLPASSES];
 
   float gate_env;
   float gate_gain;
-} PlateVerb;
+
+  // Tail estimate (see Tail Estimate)
+  float tail_env;           // tank output mean square, smoothed
+  float tail_in;            // input peak still on its way through the tank
+  float tail_hold;          // seconds until that input has come out of it
+  float tail_seconds;
+
+  int quality;              // QUALITY_*
+#ifdef PLATEVERB_CPU_BUDGET
+  int budget_slot;          // -1: registry full, always full quality
+  float budget_load;        // full-quality cost / real time, smoothed
+  float budget_env;         // input peak envelope, decaying at RT60
+#endif
+
+  IIR1Coefs hp_coefs;
+  IIR1Coefs damp_coefs;
+
+  // Per-chunk scratch
+  float wet[BLOCK_LEN];     // conditioned input
+  float sumL[BLOCK_LEN];    // comb sums
+  float sumR[BLOCK_LEN];
+  float fb_mod[BLOCK_LEN];  // gate feedback scale seen by each sample's comb write
+  float lfoS[BLOCK_LEN];    // LFO per sample
+  float lfoC[BLOCK_LEN];
+  float apPos[BLOCK_LEN];   // fractional allpass read positions
+  float apTmp[BLOCK_LEN];
+  float combZL[NUM_COMBS][BLOCK_LEN];   // damped comb feedback
+  float combZR[NUM_COMBS][BLOCK_LEN];
+
+  // Control storage for the embedding API (plateverb.h)
+  float controls[PLATEVERB_NUM_PORTS];
+
+#ifdef PLATEVERB_PARALLEL
+  // The DSP reads `snap`, taken once per frame; the host's ports live here
+  void* host[PLATEVERB_NUM_PORTS];
+  float snap[PLATEVERB_NUM_PORTS];
+  ParallelJob jobs[2];      // frame being filled, frame being processed
+  int par_cur;              // index of the frame being filled
+  uint32_t par_pos;         // samples filled so far
+  float par_tail;           // tail estimate of the last collected frame
+  int par_adopted;          // host scheduling published (par_adopt)
+#endif
+};
 
 static void set_default_base_delays(PlateVerb* self, float fs) {
   const float fs_ratio = fs > 1.0f ? (fs / 48000.0f) : 1.0f;
-  const int combL_ref[NUM_COMBS] = { 1201, 1553, 1867, 2203 };
-  const int combR_ref[NUM_COMBS] = { 1319, 1613, 1973, 2411 };
-  const int apL_ref[NUM_ALLPASSES] = { 239, 421 };
-  const int apR_ref[NUM_ALLPASSES] = { 263, 463 };
+  static const int combL_ref[NUM_COMBS] = { PLATEVERB_COMBS(PLATEVERB_COMB_L_) };
+  static const int combR_ref[NUM_COMBS] = { PLATEVERB_COMBS(PLATEVERB_COMB_R_) };
+  static const int apL_ref[NUM_ALLPASSES] = { PLATEVERB_ALLPASSES(PLATEVERB_AP_L_) };
+  static const int apR_ref[NUM_ALLPASSES] = { PLATEVERB_ALLPASSES(PLATEVERB_AP_R_) };
 
   for (int i = 0; i < NUM_COMBS; ++i) {
     int DL = (int)lrintf(combL_ref[i] * fs_ratio);
@@ -209,39 +618,287 @@ static void set_default_base_delays(PlateVerb* self, float fs) {
 
 static inline float comb_gain_from_rt60(float rt60, int D, float fs) {
   if (rt60 < 0.05f) rt60 = 0.05f;
-  const float g = powf(10.0f, (-3.0f * (float)D) / (rt60 * fs));
+  const float g = dsp_exp10f((-3.0f * (float)D) / (rt60 * fs));
   return clampf(g, 0.0f, 0.9999f);
 }
 
-static LV2_Handle instantiate(const LV2_Descriptor* d, double rate, const char* p, const LV2_Feature* const* f) {
-  (void)d; (void)p; (void)f;
-  PlateVerb* self = (PlateVerb*)calloc(1, sizeof(PlateVerb));
-  if (!self) return NULL;
+// ----- Size Tiers -----
+static inline int tier_for_size(float sizeK) {
+  for (int t = 0; t < NUM_SIZE_TIERS - 1; ++t) {
+    if (sizeK <= size_tiers[t]) return t;
+  }
+  return NUM_SIZE_TIERS - 1;
+}
 
-  self->sample_rate = (float)(rate > 1.0 ? rate : 48000.0);
-  
-  set_default_base_delays(self, self->sample_rate);
-  self->max_comb_len     = MAX_MS(80.0f, self->sample_rate);
-  self->max_ap_len       = MAX_MS(50.0f, self->sample_rate); 
-  self->max_predelay_len = MAX_MS(220.0f, self->sample_rate);
+static void tier_lengths(const PlateVerb* self, int tier, int* comb_len, int* ap_len) {
+  int comb_max = 0, ap_max = 0;
+  for (int i = 0; i < NUM_COMBS; ++i) {
+    if (self->baseCombL[i] > comb_max) comb_max = self->baseCombL[i];
+    if (self->baseCombR[i] > comb_max) comb_max = self->baseCombR[i];
+  }
+  for (int i = 0; i < NUM_ALLPASSES; ++i) {
+    if (self->baseApL[i] > ap_max) ap_max = self->baseApL[i];
+    if (self->baseApR[i] > ap_max) ap_max = self->baseApR[i];
+  }
+  *comb_len = (int)ceilf((float)comb_max * size_tiers[tier]) + 4;
+  *ap_len   = (int)ceilf((float)ap_max * size_tiers[tier]) + MAX_MS(MOD_MAX_MS, self->sample_rate) + 4;
+}
+
+// Lines of equal length (all combs, all allpasses) advance their write
+// index in lockstep, so their write pointers keep a fixed distance forever.
+// When that distance is within a cache line or so of a multiple of 4 KiB
+// they hit the same L1 sets (set conflicts on the A53, 4K aliasing on x86).
+// With PLATEVERB_ARENA_STAGGER_LINES = k, a line that would start less than
+// k cache lines (mod 4 KiB) from an earlier line of its group is moved on
+// by whole cache lines until it does not; the pad is worked out per line
+// and is zero unless the lengths happen to alias. Off by default: no
+// measurement has shown a win yet; `make bench-stagger` compares settings
+// under perf stat.
+#ifndef PLATEVERB_ARENA_STAGGER_LINES
+#define PLATEVERB_ARENA_STAGGER_LINES 0
+#endif
+#define CACHE_LINE_BYTES  64
+#define CACHE_LINE_FLOATS (CACHE_LINE_BYTES / (int)sizeof(float))
+#define ALIAS_SPAN_BYTES  4096
+#define ARENA_LINES       (1 + 2 * NUM_COMBS + 2 * NUM_ALLPASSES)
 
-  delay_init(&self->predelay, self->max_predelay_len);
+// Start of every line for `tier`, in floats from the arena's first cache
+// line boundary and in tank_lines() order. Returns the floats spanned.
+static size_t tier_offsets(const PlateVerb* self, int tier, size_t* off) {
+  int comb_len, ap_len;
+  tier_lengths(self, tier, &comb_len, &ap_len);
+  size_t cursor = 0;
+  for (int k = 0; k < ARENA_LINES; ++k) {
+    const int is_comb = (k >= 1 && k <= 2 * NUM_COMBS);
+    const int len = (k == 0) ? self->max_predelay_len : is_comb ? comb_len : ap_len;
+    size_t at = (cursor + CACHE_LINE_FLOATS - 1) / CACHE_LINE_FLOATS * CACHE_LINE_FLOATS;
+#if PLATEVERB_ARENA_STAGGER_LINES
+    const int first = (k == 0) ? 0 : is_comb ? 1 : 1 + 2 * NUM_COMBS;
+    const size_t gap = (size_t)PLATEVERB_ARENA_STAGGER_LINES * CACHE_LINE_BYTES;
+    for (int j = first, tries = 0; j < k && tries < ALIAS_SPAN_BYTES / CACHE_LINE_BYTES; ) {
+      const size_t d = ((at - off[j]) * sizeof(float)) % ALIAS_SPAN_BYTES;
+      if (d < gap || d > ALIAS_SPAN_BYTES - gap) {
+        at += CACHE_LINE_FLOATS;
+        j = first;
+        ++tries;
+      } else {
+        ++j;
+      }
+    }
+#endif
+    off[k] = at;
+    cursor = at + (size_t)len;
+  }
+  return cursor;
+}
 
+static size_t tier_floats(const PlateVerb* self, int tier) {
+  size_t off[ARENA_LINES];
+  // The arena itself may start anywhere within a cache line
+  return tier_offsets(self, tier, off) + CACHE_LINE_FLOATS;
+}
+
+// Carve the arena into delay lines for `tier`. Only buffers and sizes are
+// set; indices, delays and filter state are left to the caller.
+static void tier_layout(PlateVerb* self, TankArena* a, int tier, Delay* pre, Delay* cl, Delay* cr, Delay* al, Delay* ar) {
+  int comb_len, ap_len;
+  tier_lengths(self, tier, &comb_len, &ap_len);
+  size_t off[ARENA_LINES];
+  tier_offsets(self, tier, off);
+  float* base = (float*)(((uintptr_t)a->data + CACHE_LINE_BYTES - 1) & ~(uintptr_t)(CACHE_LINE_BYTES - 1));
+  int k = 0;
+  delay_init(pre, base + off[k++], self->max_predelay_len);
   for (int i = 0; i < NUM_COMBS; ++i) {
-    comb_init(&self->combL[i], self->max_comb_len, self->baseCombL[i], 0.7f, 0.7f);
-    comb_init(&self->combR[i], self->max_comb_len, self->baseCombR[i], 0.7f, 0.7f);
+    delay_init(&cl[i], base + off[k++], comb_len);
+    delay_init(&cr[i], base + off[k++], comb_len);
   }
   for (int i = 0; i < NUM_ALLPASSES; ++i) {
-    allpass_init(&self->apL[i], self->max_ap_len, self->baseApL[i], 0.7f);
-    allpass_init(&self->apR[i], self->max_ap_len, self->baseApR[i], 0.7f);
+    delay_init(&al[i], base + off[k++], ap_len);
+    delay_init(&ar[i], base + off[k++], ap_len);
   }
-  
-  self->gate_gain = 1.0f;
-  return (LV2_Handle)self;
 }
 
-static void connect_port(LV2_Handle instance, uint32_t port, void* data_location) {
-  PlateVerb* self = (PlateVerb*)instance;
+// Every delay line, in tier_layout() order
+static void tank_lines(const PlateVerb* self, const Delay** lines) {
+  int k = 0;
+  lines[k++] = &self->predelay;
+  for (int i = 0; i < NUM_COMBS; ++i) {
+    lines[k++] = &self->combL[i].delay;
+    lines[k++] = &self->combR[i].delay;
+  }
+  for (int i = 0; i < NUM_ALLPASSES; ++i) {
+    lines[k++] = &self->apL[i].delay;
+    lines[k++] = &self->apR[i].delay;
+  }
+}
+
+// A new arena takes over the newest min(old, new length) samples of every
+// line. The worker copies them as they stood when the request was made
+// (tier_snapshot); run() keeps writing the old lines meanwhile, so the
+// audio thread only copies what it has written since (tier_install). Every
+// line advances by the same tank_frames, so one count covers all of them.
+//
+// Worker side: copy the history of `src`, as of write index `idx`, to the
+// start of the zeroed line `dst`.
+static void delay_snapshot(Delay* dst, const Delay* src, int idx) {
+  const int m = (src->size < dst->size) ? src->size : dst->size;
+  Delay then = *src;
+  then.idx = idx;
+  delay_read_block(&then, m, dst->buf, (uint32_t)m);
+}
+
+// Audio side: append the `since` samples `src` has taken after the
+// snapshot. Snapshot slots older than the history may have been overwritten
+// in `src` while the worker read them, so they are cleared. Falls back to a
+// full copy when the worker took longer than the history.
+static void delay_catch_up(Delay* dst, const Delay* src, uint32_t since) {
+  const int m = (src->size < dst->size) ? src->size : dst->size;
+  dst->idx = (m < dst->size) ? m : 0;
+  if (since >= (uint32_t)m) {
+    delay_read_block(src, m, dst->buf, (uint32_t)m);
+    return;
+  }
+  const int n = (int)since;
+  int start = src->idx - n;
+  if (start < 0) start += src->size;
+  const int first = (src->size - start < n) ? src->size - start : n;
+  memset(dst->buf, 0, (size_t)n * sizeof(float));
+  delay_write_block(dst, src->buf + start, (uint32_t)first);
+  delay_write_block(dst, src->buf, (uint32_t)(n - first));
+}
+
+// Runs in work(): lay out `a` for `tier` and copy the history into it
+static void tier_snapshot(PlateVerb* self, TankArena* a, int tier, const int32_t* idx) {
+  Delay pre, cl[NUM_COMBS], cr[NUM_COMBS], al[NUM_ALLPASSES], ar[NUM_ALLPASSES];
+  tier_layout(self, a, tier, &pre, cl, cr, al, ar);
+  int k = 0;
+  delay_snapshot(&pre, &self->predelay, idx[k++]);
+  for (int i = 0; i < NUM_COMBS; ++i) {
+    delay_snapshot(&cl[i], &self->combL[i].delay, idx[k++]);
+    delay_snapshot(&cr[i], &self->combR[i].delay, idx[k++]);
+  }
+  for (int i = 0; i < NUM_ALLPASSES; ++i) {
+    delay_snapshot(&al[i], &self->apL[i].delay, idx[k++]);
+    delay_snapshot(&ar[i], &self->apR[i].delay, idx[k++]);
+  }
+}
+
+// Length of the tap crossfade after a tier swap. Taps the old lines had to
+// clamp would otherwise jump to their full length in one sample.
+#define TIER_XFADE  (2 * BLOCK_LEN)
+
+// Runs in run() context (work_response): bring the snapshot `a` up to date
+// with the `frames` written since, swap it in and start the tap crossfade.
+// The old arena is freed by the worker later.
+static void tier_install(PlateVerb* self, TankArena* a, int tier, uint32_t frames) {
+  Delay pre, cl[NUM_COMBS], cr[NUM_COMBS], al[NUM_ALLPASSES], ar[NUM_ALLPASSES];
+  tier_layout(self, a, tier, &pre, cl, cr, al, ar);
+  const uint32_t since = self->tank_frames - frames;
+  const int ap_headroom = MAX_MS(MOD_MAX_MS, self->sample_rate);
+
+  delay_catch_up(&pre, &self->predelay, since);
+  self->predelay = pre;
+  for (int i = 0; i < NUM_COMBS; ++i) {
+    delay_catch_up(&cl[i], &self->combL[i].delay, since); self->combL[i].delay = cl[i];
+    delay_catch_up(&cr[i], &self->combR[i].delay, since); self->combR[i].delay = cr[i];
+    self->xfadeCombL[i] = (self->combL[i].D < cl[i].size) ? self->combL[i].D : cl[i].size - 1;
+    self->xfadeCombR[i] = (self->combR[i].D < cr[i].size) ? self->combR[i].D : cr[i].size - 1;
+  }
+  for (int i = 0; i < NUM_ALLPASSES; ++i) {
+    delay_catch_up(&al[i], &self->apL[i].delay, since); self->apL[i].delay = al[i];
+    delay_catch_up(&ar[i], &self->apR[i].delay, since); self->apR[i].delay = ar[i];
+    self->xfadeApL[i] = (self->apL[i].D < al[i].size - ap_headroom) ? self->apL[i].D : al[i].size - ap_headroom;
+    self->xfadeApR[i] = (self->apR[i].D < ar[i].size - ap_headroom) ? self->apR[i].D : ar[i].size - ap_headroom;
+  }
+  self->xfade_left = TIER_XFADE;
+  tier_lengths(self, tier, &self->max_comb_len, &self->max_ap_len);
+  self->retired = self->arena;
+  self->arena = a;
+  self->tier = tier;
+}
+
+// ----- CPU Budget -----
+#ifdef PLATEVERB_CPU_BUDGET
+// PLATEVERB_CPU_BUDGET is the share of one core that all instances in the
+// process may use together (e.g. 0.5). Each instance holds a slot in a
+// lock-free registry and after every run() publishes what a full-quality
+// run costs relative to real time, and how audible it is (mix x input
+// envelope). Every instance then picks its own quality from the same
+// snapshot: while the summed demand is over budget, instances step down in
+// order of audibility until the estimated savings cover the excess.
+#ifdef PLATEVERB_DETERMINISTIC
+#error "the CPU budget picks quality from timing; build deterministic renders without it"
+#endif
+#define BUDGET_SLOTS  32
+#define LITE_SAVING   0.3f   // share of a full run saved by QUALITY_LITE
+
+typedef struct {
+  atomic_int used;
+  _Atomic float load;
+  _Atomic float importance;
+} BudgetSlot;
+
+static BudgetSlot budget_slots[BUDGET_SLOTS];
+
+static int budget_join(void) {
+  for (int i = 0; i < BUDGET_SLOTS; ++i) {
+    int expected = 0;
+    if (atomic_compare_exchange_strong(&budget_slots[i].used, &expected, 1)) return i;
+  }
+  return -1;
+}
+
+static void budget_leave(int slot) {
+  if (slot < 0) return;
+  // Free slots read as zero load, so others need not check `used`
+  atomic_store_explicit(&budget_slots[slot].load, 0.0f, memory_order_relaxed);
+  atomic_store_explicit(&budget_slots[slot].importance, 0.0f, memory_order_relaxed);
+  atomic_store_explicit(&budget_slots[slot].used, 0, memory_order_release);
+}
+
+// Monotonic: a wall-clock step (NTP, suspend) must not read as a load spike
+static inline double budget_clock(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+// `peak` is the input peak of the block just run, taken before the outputs
+// (which may alias the input) were written.
+static void budget_update(PlateVerb* self, float peak, double elapsed, uint32_t n_samples) {
+  if (self->budget_slot < 0 || n_samples == 0) return;
+  const float mix  = self->p_mix        ? clampf(*self->p_mix,        0.0f, 1.0f)  : 0.25f;
+  const float rt60 = self->p_decay_rt60 ? clampf(*self->p_decay_rt60, 0.1f, 20.0f) : 2.5f;
+  const float period = (float)n_samples / self->sample_rate;
+
+  // The tail a burst leaves behind stays audible for about RT60
+  self->budget_env = maxf(peak, self->budget_env * powf(10.0f, -3.0f * period / rt60));
+  // Demand: lite runs are scaled back up to what full quality would cost;
+  // idle instances are silent, so what they actually cost is their demand
+  float load = (float)elapsed / period;
+  if (self->quality == QUALITY_LITE) load /= 1.0f - LITE_SAVING;
+  self->budget_load += 0.1f * (load - self->budget_load);
+  const float importance = mix * self->budget_env;
+  atomic_store_explicit(&budget_slots[self->budget_slot].load, self->budget_load, memory_order_relaxed);
+  atomic_store_explicit(&budget_slots[self->budget_slot].importance, importance, memory_order_relaxed);
+
+  float demand = 0.0f;
+  float saved_below = 0.0f;     // what stepping down every less audible instance saves
+  for (int i = 0; i < BUDGET_SLOTS; ++i) {
+    const float load = atomic_load_explicit(&budget_slots[i].load, memory_order_relaxed);
+    const float imp  = atomic_load_explicit(&budget_slots[i].importance, memory_order_relaxed);
+    demand += load;
+    if (imp < importance || (imp == importance && i < self->budget_slot)) saved_below += load * LITE_SAVING;
+  }
+  const float excess = demand - (float)PLATEVERB_CPU_BUDGET;
+  if (excess <= 0.0f || saved_below >= excess) self->quality = QUALITY_FULL;
+  else self->quality = (self->budget_env < SILENCE_FLOOR) ? QUALITY_IDLE : QUALITY_LITE;
+}
+#endif
+
+// Point the DSP at a port buffer. connect_port() normally does this
+// directly; the parallel build points the DSP at its own copies instead.
+static void dsp_connect(PlateVerb* self, uint32_t port, void* data_location) {
   switch (port) {
     case 0: self->in            = (const float*)data_location; break;
     case 1: self->out_l         = (float*)data_location; break;
@@ -257,65 +914,640 @@ static void connect_port(LV2_Handle instance, uint32_t port, void* data_location
     case 11: self->p_mod_rate   = (const float*)data_location; break;
     case 12: self->p_locut      = (const float*)data_location; break;
     case 13: self->p_grit       = (const float*)data_location; break;
+    case 14: self->p_early      = (const float*)data_location; break;
+    case 15: self->p_latency    = (float*)data_location; break;
+    case 16: self->p_tail       = (float*)data_location; break;
     default: break;
   }
 }
 
-static void activate(LV2_Handle instance) {
+// ----- Parallel Engine -----
+#ifdef PLATEVERB_PARALLEL
+// Opt-in (PLATEVERB_PARALLEL = frame length in samples), for hosts that run
+// every plugin serially on one core. run() only moves audio through two
+// frame buffers per instance; each full frame is queued to a process-wide
+// pool of worker threads on the spare cores. A frame's output is collected
+// when the next frame starts, normally in the host's next period, so the
+// plugin reports PLATEVERB_PARALLEL samples of latency. A job nobody has
+// picked up by then is stolen and run by the waiting thread, so the result
+// is the same with no spare cores, only without the speedup. A job that is
+// already running is waited for on a semaphore, not spun on; the workers
+// take the scheduling policy of the host's audio thread (see par_adopt), so
+// the thread they block is not left waiting behind ordinary threads.
+// plateverb_process_batch() uses the same pool without the latency: it
+// queues one job per instance and joins them before it returns.
+#define PAR_QUEUE_LEN   64   // power of two
+#define PAR_MAX_WORKERS 8
+
+// JOB_WAITED: running, and the owner sleeps on `done` until it finishes
+enum { JOB_IDLE = 0, JOB_QUEUED, JOB_RUNNING, JOB_WAITED, JOB_DONE };
+
+static void run_kernel(PlateVerb* self, uint32_t n_samples);
+static void tier_update(PlateVerb* self, float sizeK);
+
+static struct {
+  pthread_mutex_t lock;     // join/leave only, never taken in run()
+  int users;
+  int n_workers;
+  pthread_t workers[PAR_MAX_WORKERS];
+  sem_t wake;
+  atomic_int stop;
+  // Bounded MPMC queue: a cell is free for the push at `pos` when its
+  // sequence equals pos, and holds a job for the pop at `pos` at pos + 1
+  struct { atomic_size_t seq; ParallelJob* job; } cells[PAR_QUEUE_LEN];
+  atomic_size_t head;
+  atomic_size_t tail;
+  // Scheduling of the host's audio thread, for the workers to follow; a
+  // worker applies it when it sees `sched_gen` change
+  atomic_int sched_gen;
+  atomic_int sched_policy;
+  atomic_int sched_priority;
+  atomic_int host_cpu;      // core the audio thread is pinned to, or -1
+} par_engine = { .lock = PTHREAD_MUTEX_INITIALIZER };
+
+static int par_push(ParallelJob* job) {
+  size_t pos = atomic_load_explicit(&par_engine.tail, memory_order_relaxed);
+  for (;;) {
+    const size_t seq = atomic_load_explicit(&par_engine.cells[pos & (PAR_QUEUE_LEN - 1)].seq, memory_order_acquire);
+    if (seq == pos) {
+      if (atomic_compare_exchange_weak_explicit(&par_engine.tail, &pos, pos + 1,
+                                                memory_order_relaxed, memory_order_relaxed)) break;
+    } else if ((ptrdiff_t)(seq - pos) < 0) {
+      return 0;             // full
+    } else {
+      pos = atomic_load_explicit(&par_engine.tail, memory_order_relaxed);
+    }
+  }
+  par_engine.cells[pos & (PAR_QUEUE_LEN - 1)].job = job;
+  atomic_store_explicit(&par_engine.cells[pos & (PAR_QUEUE_LEN - 1)].seq, pos + 1, memory_order_release);
+  return 1;
+}
+
+static ParallelJob* par_pop(void) {
+  size_t pos = atomic_load_explicit(&par_engine.head, memory_order_relaxed);
+  for (;;) {
+    const size_t seq = atomic_load_explicit(&par_engine.cells[pos & (PAR_QUEUE_LEN - 1)].seq, memory_order_acquire);
+    if (seq == pos + 1) {
+      if (atomic_compare_exchange_weak_explicit(&par_engine.head, &pos, pos + 1,
+                                                memory_order_relaxed, memory_order_relaxed)) break;
+    } else if ((ptrdiff_t)(seq - (pos + 1)) < 0) {
+      return NULL;          // empty
+    } else {
+      pos = atomic_load_explicit(&par_engine.head, memory_order_relaxed);
+    }
+  }
+  ParallelJob* job = par_engine.cells[pos & (PAR_QUEUE_LEN - 1)].job;
+  atomic_store_explicit(&par_engine.cells[pos & (PAR_QUEUE_LEN - 1)].seq, pos + PAR_QUEUE_LEN, memory_order_release);
+  return job;
+}
+
+static void par_run_job(ParallelJob* job) {
+  PlateVerb* self = job->owner;
+  self->in = job->src;
+  self->out_l = job->dst_l;
+  self->out_r = job->dst_r;
+  run_kernel(self, job->n);
+  job->tail = self->tail_seconds;
+  if (atomic_exchange_explicit(&job->state, JOB_DONE, memory_order_acq_rel) == JOB_WAITED) {
+    sem_post(&job->done);
+  }
+}
+
+// Whoever moves a job from QUEUED to RUNNING runs it. A stolen job may still
+// sit in the queue; the worker that pops it later finds it no longer QUEUED.
+static int par_claim(ParallelJob* job) {
+  int expected = JOB_QUEUED;
+  return atomic_compare_exchange_strong_explicit(&job->state, &expected, JOB_RUNNING,
+                                                 memory_order_acquire, memory_order_relaxed);
+}
+
+// Apply the host's scheduling to the calling worker: its policy one step
+// below its priority, so the audio thread still wins a shared core, and on
+// Linux every core but the one the audio thread is pinned to. Either call
+// fails without the rights to make it (e.g. no rtprio limit) and leaves the
+// worker as it was.
+static void par_follow_host(void) {
+  const int policy = atomic_load_explicit(&par_engine.sched_policy, memory_order_relaxed);
+  const int prio = atomic_load_explicit(&par_engine.sched_priority, memory_order_relaxed);
+  struct sched_param sp;
+  memset(&sp, 0, sizeof(sp));
+  if (policy == SCHED_FIFO || policy == SCHED_RR) {
+    sp.sched_priority = (prio > sched_get_priority_min(policy)) ? prio - 1 : prio;
+  }
+  pthread_setschedparam(pthread_self(), policy, &sp);
+#ifdef __linux__
+  const int host_cpu = atomic_load_explicit(&par_engine.host_cpu, memory_order_relaxed);
+  const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (long c = 0; c < cores && c < CPU_SETSIZE; ++c) {
+    if (c != host_cpu) CPU_SET((int)c, &set);
+  }
+  if (CPU_COUNT(&set) > 0) pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+static void* par_worker(void* arg) {
+  (void)arg;
+  int gen = 0;
+  for (;;) {
+    while (sem_wait(&par_engine.wake) != 0) {}
+    if (atomic_load_explicit(&par_engine.stop, memory_order_acquire)) return NULL;
+    const int g = atomic_load_explicit(&par_engine.sched_gen, memory_order_acquire);
+    if (g != gen) {
+      gen = g;
+      par_follow_host();
+    }
+    ParallelJob* job;
+    while ((job = par_pop())) {
+      if (par_claim(job)) par_run_job(job);
+      // Last touch of the job: after this its instance may be freed
+      atomic_fetch_sub_explicit(&job->queued, 1, memory_order_release);
+    }
+  }
+}
+
+// Steal the job if nobody has started it, else sleep until it is done
+static void par_wait(ParallelJob* job) {
+  if (par_claim(job)) {
+    par_run_job(job);
+    return;
+  }
+  int expected = JOB_RUNNING;
+  if (atomic_compare_exchange_strong_explicit(&job->state, &expected, JOB_WAITED,
+                                              memory_order_acquire, memory_order_acquire)) {
+    while (sem_wait(&job->done) != 0) {}
+  }
+}
+
+// Publish the calling (audio) thread's policy, priority and pinned core for
+// the workers, if they changed. Runs once per instance, on its first run().
+static void par_adopt(void) {
+  int policy;
+  struct sched_param sp;
+  if (pthread_getschedparam(pthread_self(), &policy, &sp) != 0) return;
+  int cpu = -1;
+#ifdef __linux__
+  cpu_set_t set;
+  if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0 && CPU_COUNT(&set) == 1) {
+    for (int c = 0; c < CPU_SETSIZE && cpu < 0; ++c) {
+      if (CPU_ISSET(c, &set)) cpu = c;
+    }
+  }
+#endif
+  if (policy == atomic_load(&par_engine.sched_policy) && sp.sched_priority == atomic_load(&par_engine.sched_priority)
+      && cpu == atomic_load(&par_engine.host_cpu)) return;
+  atomic_store_explicit(&par_engine.sched_policy, policy, memory_order_relaxed);
+  atomic_store_explicit(&par_engine.sched_priority, sp.sched_priority, memory_order_relaxed);
+  atomic_store_explicit(&par_engine.host_cpu, cpu, memory_order_relaxed);
+  atomic_fetch_add_explicit(&par_engine.sched_gen, 1, memory_order_release);
+  // Wake every worker so each applies it before the next job
+  for (int i = 0; i < par_engine.n_workers; ++i) sem_post(&par_engine.wake);
+}
+
+// Let both frames finish, e.g. before the tank is swapped or cleared
+static void par_quiesce(PlateVerb* self) {
+  par_wait(&self->jobs[0]);
+  par_wait(&self->jobs[1]);
+}
+
+// Latch the host's controls for the next frame; ports the host left
+// unconnected stay NULL so the DSP falls back to its defaults.
+static void par_snapshot(PlateVerb* self) {
+  for (uint32_t p = PLATEVERB_MIX; p < PLATEVERB_NUM_PORTS; ++p) {
+    const float* v = (const float*)self->host[p];
+    if (v) self->snap[p] = *v;
+    dsp_connect(self, p, v ? &self->snap[p] : NULL);
+  }
+}
+
+static void par_submit(PlateVerb* self, ParallelJob* job, const float* src,
+                       float* dst_l, float* dst_r, uint32_t n) {
+  par_snapshot(self);
+  job->src = src;
+  job->dst_l = dst_l;
+  job->dst_r = dst_r;
+  job->n = n;
+  // Release: a worker may claim the job through a stale queue entry
+  atomic_store_explicit(&job->state, JOB_QUEUED, memory_order_release);
+  // If the queue is full, or there are no workers to drain it, the job
+  // stays QUEUED and par_wait() runs it
+  atomic_fetch_add_explicit(&job->queued, 1, memory_order_relaxed);
+  if (par_engine.n_workers > 0 && par_push(job)) sem_post(&par_engine.wake);
+  else atomic_fetch_sub_explicit(&job->queued, 1, memory_order_relaxed);
+}
+
+static void par_join(PlateVerb* self) {
+  for (int j = 0; j < 2; ++j) {
+    self->jobs[j].owner = self;
+    atomic_store(&self->jobs[j].queued, 0);
+    sem_init(&self->jobs[j].done, 0, 0);
+  }
+  pthread_mutex_lock(&par_engine.lock);
+  if (par_engine.users++ == 0) {
+    for (size_t i = 0; i < PAR_QUEUE_LEN; ++i) atomic_store(&par_engine.cells[i].seq, i);
+    atomic_store(&par_engine.head, 0);
+    atomic_store(&par_engine.tail, 0);
+    atomic_store(&par_engine.stop, 0);
+    atomic_store(&par_engine.sched_gen, 0);
+    atomic_store(&par_engine.sched_policy, SCHED_OTHER);
+    atomic_store(&par_engine.sched_priority, 0);
+    atomic_store(&par_engine.host_cpu, -1);
+    sem_init(&par_engine.wake, 0, 0);
+    // The host's own audio thread keeps one core busy
+    const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int want = cores > 1 ? (int)cores - 1 : 1;
+    if (want > PAR_MAX_WORKERS) want = PAR_MAX_WORKERS;
+    par_engine.n_workers = 0;
+    for (int i = 0; i < want; ++i) {
+      if (pthread_create(&par_engine.workers[par_engine.n_workers], NULL, par_worker, NULL) == 0) {
+        par_engine.n_workers++;
+      }
+    }
+  }
+  pthread_mutex_unlock(&par_engine.lock);
+}
+
+// After par_quiesce(). A job that was stolen leaves its queue entry behind,
+// and a worker may pop it at any time while the pool runs: wait until every
+// entry for this instance is gone before its memory can be freed. The
+// workers block on nothing but the queue, so this is a short sleep loop.
+static void par_leave(PlateVerb* self) {
+  const struct timespec nap = { 0, 100000 };
+  for (int j = 0; j < 2; ++j) {
+    while (atomic_load_explicit(&self->jobs[j].queued, memory_order_acquire) > 0) nanosleep(&nap, NULL);
+  }
+  for (int j = 0; j < 2; ++j) sem_destroy(&self->jobs[j].done);
+  pthread_mutex_lock(&par_engine.lock);
+  if (--par_engine.users == 0) {
+    atomic_store_explicit(&par_engine.stop, 1, memory_order_release);
+    for (int i = 0; i < par_engine.n_workers; ++i) sem_post(&par_engine.wake);
+    for (int i = 0; i < par_engine.n_workers; ++i) pthread_join(par_engine.workers[i], NULL);
+    sem_destroy(&par_engine.wake);
+  }
+  pthread_mutex_unlock(&par_engine.lock);
+}
+
+// run() body: stream the host buffers through the frames. Input is copied
+// before output is written since the host may process in place.
+static void par_run(PlateVerb* self, uint32_t n_samples) {
+  const float* in = (const float*)self->host[PLATEVERB_IN];
+  float* out_l = (float*)self->host[PLATEVERB_OUT_L];
+  float* out_r = (float*)self->host[PLATEVERB_OUT_R];
+  if (!self->par_adopted) {
+    par_adopt();
+    self->par_adopted = 1;
+  }
+  uint32_t i = 0;
+  while (i < n_samples) {
+    ParallelJob* fill = &self->jobs[self->par_cur];
+    ParallelJob* prev = &self->jobs[self->par_cur ^ 1];
+    if (self->par_pos == 0) {
+      par_wait(prev);
+      self->par_tail = prev->tail;
+      const float* size = (const float*)self->host[PLATEVERB_SIZE];
+      tier_update(self, size ? clampf(*size, SIZE_KNOB_MIN, SIZE_KNOB_MAX) : 1.0f);
+    }
+    const uint32_t room = PLATEVERB_PARALLEL - self->par_pos;
+    const uint32_t n = (n_samples - i < room) ? (n_samples - i) : room;
+    if (in) memcpy(fill->in + self->par_pos, in + i, n * sizeof(float));
+    else memset(fill->in + self->par_pos, 0, n * sizeof(float));
+    memcpy(out_l + i, prev->out_l + self->par_pos, n * sizeof(float));
+    memcpy(out_r + i, prev->out_r + self->par_pos, n * sizeof(float));
+    self->par_pos += n;
+    i += n;
+    if (self->par_pos == PLATEVERB_PARALLEL) {
+      par_submit(self, fill, fill->in, fill->out_l, fill->out_r, PLATEVERB_PARALLEL);
+      self->par_cur ^= 1;
+      self->par_pos = 0;
+    }
+  }
+}
+#endif
+
+// ----- LV2 Worker -----
+typedef enum { TANK_MSG_ALLOC, TANK_MSG_FREE } TankMsgType;
+
+typedef struct {
+  TankMsgType type;
+  int tier;
+  TankArena* arena;
+  uint32_t frames;          // ALLOC: tank_frames when requested
+  int32_t idx[ARENA_LINES]; // ALLOC: write indices when requested
+} TankMsg;
+
+static LV2_Worker_Status work(LV2_Handle instance, LV2_Worker_Respond_Function respond,
+                              LV2_Worker_Respond_Handle handle, uint32_t size, const void* data) {
+  PlateVerb* self = (PlateVerb*)instance;
+  if (size != sizeof(TankMsg)) return LV2_WORKER_ERR_UNKNOWN;
+  TankMsg msg;
+  memcpy(&msg, data, sizeof(msg));
+
+  if (msg.type == TANK_MSG_FREE) {
+    arena_release(msg.arena);
+    return LV2_WORKER_SUCCESS;
+  }
+  // Pooled arenas are dirty; the snapshot relies on a zeroed arena
+  msg.arena = arena_acquire(tier_floats(self, msg.tier));
+  if (msg.arena) {
+    memset(msg.arena->data, 0, msg.arena->n_floats * sizeof(float));
+    tier_snapshot(self, msg.arena, msg.tier, msg.idx);
+  }
+  return respond(handle, sizeof(msg), &msg);
+}
+
+static LV2_Worker_Status work_response(LV2_Handle instance, uint32_t size, const void* data) {
   PlateVerb* self = (PlateVerb*)instance;
-  if (self->predelay.buf) { memset(self->predelay.buf, 0, (size_t)self->predelay.size * sizeof(float)); self->predelay.idx = 0; }
+  if (size != sizeof(TankMsg)) return LV2_WORKER_ERR_UNKNOWN;
+  TankMsg msg;
+  memcpy(&msg, data, sizeof(msg));
+  self->tier_pending = 0;
+#ifdef PLATEVERB_PARALLEL
+  par_quiesce(self);
+#endif
+  if (msg.arena && self->tier_stale) {
+    self->retired = msg.arena;  // taken before activate() cleared the lines
+  } else if (msg.arena) {
+    tier_install(self, msg.arena, msg.tier, msg.frames);
+  }
+  self->tier_stale = 0;
+  return LV2_WORKER_SUCCESS;
+}
+
+static const LV2_Worker_Interface worker_iface = { work, work_response, NULL };
+
+// Called at the top of run(), or between frames in the parallel build (no
+// job may be writing the lines): hand retired arenas to the worker and ask
+// for a new one when Size has left the current tier.
+static void tier_update(PlateVerb* self, float sizeK) {
+  if (!self->schedule) return;
+  if (self->retired) {
+    const TankMsg msg = { TANK_MSG_FREE, 0, self->retired, 0, { 0 } };
+    if (self->schedule->schedule_work(self->schedule->handle, sizeof(msg), &msg) == LV2_WORKER_SUCCESS) {
+      self->retired = NULL;
+    }
+    return;
+  }
+  const int want = tier_for_size(sizeK);
+  if (want != self->tier && !self->tier_pending) {
+    TankMsg msg = { TANK_MSG_ALLOC, want, NULL, self->tank_frames, { 0 } };
+    const Delay* lines[ARENA_LINES];
+    tank_lines(self, lines);
+    for (int k = 0; k < ARENA_LINES; ++k) msg.idx[k] = lines[k]->idx;
+    if (self->schedule->schedule_work(self->schedule->handle, sizeof(msg), &msg) == LV2_WORKER_SUCCESS) {
+      self->tier_pending = 1;
+    }
+  }
+}
+
+static LV2_Handle instantiate(const LV2_Descriptor* d, double rate, const char* p, const LV2_Feature* const* f) {
+  (void)d; (void)p;
+  PlateVerb* self = (PlateVerb*)calloc(1, sizeof(PlateVerb));
+  if (!self) return NULL;
+
+  for (int i = 0; f && f[i]; ++i) {
+    if (!strcmp(f[i]->URI, LV2_WORKER__schedule)) self->schedule = (const LV2_Worker_Schedule*)f[i]->data;
+  }
+
+  self->sample_rate = (float)(rate > 1.0 ? rate : 48000.0);
+  
+  set_default_base_delays(self, self->sample_rate);
+  // Room for the longest predelay plus the early-reflection taps behind it
+  self->max_predelay_len = MAX_MS(200.0f + ER_SPAN_MS * SIZE_KNOB_MAX, self->sample_rate) + BLOCK_LEN;
+
+  // Without a worker there is no way to grow later, so take the largest tier
+  self->tier = self->schedule ? tier_for_size(1.0f) : NUM_SIZE_TIERS - 1;
+  tier_lengths(self, self->tier, &self->max_comb_len, &self->max_ap_len);
+
+  self->arena = arena_acquire(tier_floats(self, self->tier));
+  if (!self->arena) { free(self); return NULL; }
+
+  Delay pre, cl[NUM_COMBS], cr[NUM_COMBS], al[NUM_ALLPASSES], ar[NUM_ALLPASSES];
+  tier_layout(self, self->arena, self->tier, &pre, cl, cr, al, ar);
+  self->predelay = pre;
   for (int i = 0; i < NUM_COMBS; ++i) {
-    if (self->combL[i].delay.buf) { memset(self->combL[i].delay.buf, 0, (size_t)self->combL[i].delay.size*4); self->combL[i].lp.z = 0; }
-    if (self->combR[i].delay.buf) { memset(self->combR[i].delay.buf, 0, (size_t)self->combR[i].delay.size*4); self->combR[i].lp.z = 0; }
+    comb_init(&self->combL[i], cl[i].buf, cl[i].size, self->baseCombL[i], 0.7f, 0.7f);
+    comb_init(&self->combR[i], cr[i].buf, cr[i].size, self->baseCombR[i], 0.7f, 0.7f);
   }
   for (int i = 0; i < NUM_ALLPASSES; ++i) {
-    if (self->apL[i].delay.buf) memset(self->apL[i].delay.buf, 0, (size_t)self->apL[i].delay.size*4);
-    if (self->apR[i].delay.buf) memset(self->apR[i].delay.buf, 0, (size_t)self->apR[i].delay.size*4);
+    allpass_init(&self->apL[i], al[i].buf, al[i].size, self->baseApL[i], 0.7f);
+    allpass_init(&self->apR[i], ar[i].buf, ar[i].size, self->baseApR[i], 0.7f);
+  }
+  
+  self->gate_gain = 1.0f;
+#ifdef PLATEVERB_CPU_BUDGET
+  self->budget_slot = budget_join();
+#endif
+#ifdef PLATEVERB_PARALLEL
+  par_join(self);
+#endif
+  return (LV2_Handle)self;
+}
+
+static void connect_port(LV2_Handle instance, uint32_t port, void* data_location) {
+  PlateVerb* self = (PlateVerb*)instance;
+#ifdef PLATEVERB_PARALLEL
+  if (port < PLATEVERB_NUM_PORTS) self->host[port] = data_location;
+#else
+  dsp_connect(self, port, data_location);
+#endif
+}
+
+static void activate(LV2_Handle instance) {
+  PlateVerb* self = (PlateVerb*)instance;
+#ifdef PLATEVERB_PARALLEL
+  par_quiesce(self);
+  for (int j = 0; j < 2; ++j) {
+    memset(self->jobs[j].out_l, 0, sizeof(self->jobs[j].out_l));
+    memset(self->jobs[j].out_r, 0, sizeof(self->jobs[j].out_r));
   }
+  self->par_cur = 0;
+  self->par_pos = 0;
+  self->par_tail = 0.0f;
+  self->jobs[0].tail = 0.0f;
+  self->jobs[1].tail = 0.0f;
+#endif
+  // Pooled arenas come back dirty; one memset clears every delay line
+  memset(self->arena->data, 0, self->arena->n_floats * sizeof(float));
+  self->tier_stale = self->tier_pending;
+  self->xfade_left = 0;
+  self->predelay.idx = 0;
+  for (int i = 0; i < NUM_COMBS; ++i) { self->combL[i].lp.z = 0; self->combR[i].lp.z = 0; }
   self->gate_env = 0.0f;
   self->gate_gain = 1.0f;
   self->lfo_phase = 0.0f;
   self->hp_in_z = 0.0f;
   self->hp_out_z = 0.0f;
+  self->tail_env = 0.0f;
+  self->tail_in = 0.0f;
+  self->tail_hold = 0.0f;
+  self->tail_seconds = 0.0f;
+#ifdef PLATEVERB_CPU_BUDGET
+  self->budget_env = 0.0f;
+#endif
 }
 
-static void run(LV2_Handle instance, uint32_t n_samples) {
-  PlateVerb* self = (PlateVerb*)instance;
+// ----- Input Stage (Predelay -> HPF -> Grit) -----
+// Depends only on predelay_ms, locut and grit, so instances sharing those
+// three knobs can share one conditioned signal (see plateverb_process_multi).
+typedef struct {
+  float pre_ms;
+  float hp_freq;
+  float grit;
+} InputKnobs;
 
-  const float* in  = self->in;
-  float* outL = self->out_l;
-  float* outR = self->out_r;
+static inline InputKnobs input_knobs(const PlateVerb* self) {
+  InputKnobs k;
+  k.pre_ms  = self->p_predelay_ms ? clampf(*self->p_predelay_ms, 0.0f, 200.0f)    : 20.0f;
+  k.hp_freq = self->p_locut       ? clampf(*self->p_locut,       10.0f, 1000.0f) : 10.0f;
+  k.grit    = self->p_grit        ? clampf(*self->p_grit,        0.0f, 1.0f)     : 0.0f;
+  return k;
+}
+
+static FORCE_INLINE void run_input(PlateVerb* self, const float fs, const float* in, float* wet, uint32_t n_samples) {
+  const InputKnobs k = input_knobs(self);
+
+  const float dt = 1.0f / fs;
+  const float rc_hp = 1.0f / (6.2831853f * k.hp_freq); 
+  const float hp_alpha = rc_hp / (rc_hp + dt);
+
+  // The whole chunk is written before it is read back
+  int pred_samp = (int)lrintf(k.pre_ms * 0.001f * fs);
+  if (pred_samp > self->predelay.size - (int)n_samples - 1) pred_samp = self->predelay.size - (int)n_samples - 1;
+
+  // Grit Pre-calculation: 1.0 (clean) to 12.0 (heavily boosted)
+  const float drive_gain = 1.0f + (k.grit * 11.0f);
 
+  // 1. Predelay
+  if (in) {
+    delay_write_block(&self->predelay, in, n_samples);
+  } else {
+    for (uint32_t n = 0; n < n_samples; ++n) delay_write(&self->predelay, 0.0f);
+  }
+  delay_read_block(&self->predelay, pred_samp + (int)n_samples, wet, n_samples);
+
+  // 2. High Pass Filter: y = alpha*y[-1] + alpha*(x - x[-1])
+  float prev = self->hp_in_z;
+  for (uint32_t n = 0; n < n_samples; ++n) {
+    const float x = wet[n];
+    wet[n] = hp_alpha * (x - prev);
+    prev = x;
+  }
+  self->hp_in_z = prev;
+  iir1_set(&self->hp_coefs, hp_alpha);
+  iir1_block(&self->hp_coefs, wet, wet, n_samples, &self->hp_out_z);
+
+  // 3. Grit (Input Saturation)
+  // Apply boost and soft clip *before* filling the tank
+  if (k.grit > 0.001f) {
+    for (uint32_t n = 0; n < n_samples; ++n) wet[n] = soft_clip(wet[n] * drive_gain);
+  }
+}
+
+// Followers in a shared input group skip run_input(); keep their input
+// state in step with the group leader so they can run standalone afterwards.
+// Only the n samples the leader just wrote are copied, unless the follower's
+// line was not in step to begin with.
+static void copy_input_state(PlateVerb* dst, const PlateVerb* src, uint32_t n) {
+  const Delay* s = &src->predelay;
+  Delay* d = &dst->predelay;
+  if (d->buf && s->buf && d->size == s->size) {
+    int start = s->idx - (int)((n < (uint32_t)s->size) ? n : (uint32_t)s->size);
+    if (start < 0) start += s->size;
+    if (n >= (uint32_t)s->size || d->idx != start) {
+      memcpy(d->buf, s->buf, (size_t)s->size * sizeof(float));
+    } else if (start <= s->idx) {
+      memcpy(d->buf + start, s->buf + start, n * sizeof(float));
+    } else {
+      memcpy(d->buf + start, s->buf + start, (size_t)(s->size - start) * sizeof(float));
+      memcpy(d->buf, s->buf, (size_t)s->idx * sizeof(float));
+    }
+    d->idx = s->idx;
+  }
+  dst->hp_in_z = src->hp_in_z;
+  dst->hp_out_z = src->hp_out_z;
+}
+
+// ----- Tail Estimate -----
+// Seconds until the output falls below SILENCE_FLOOR if the input stopped
+// now. Updated once per chunk from the tank's mean square: its envelope
+// is extrapolated down to the floor at RT60. The envelope follows the
+// tank's actual decay, which damping makes faster than RT60, instead of
+// holding its peak and decaying at RT60 itself, which ran some 20-25 dB
+// past the floor. Input still crossing the predelay and the combs has not
+// reached the tank output yet, so its peak counts too until it has.
+#define TAIL_CREST   8.0f   // peak over smoothed RMS, sparse impulse tails too (18 dB)
+#define TAIL_SMOOTH  0.05f  // seconds, release of the mean-square envelope
+
+static void tail_update(PlateVerb* self, const float fs, float in_peak, float tank_ms, uint32_t n_samples) {
+  const float mix      = self->p_mix        ? clampf(*self->p_mix,        0.0f, 1.0f)  : 0.25f;
+  const float rt60     = self->p_decay_rt60 ? clampf(*self->p_decay_rt60, 0.1f, 20.0f) : 2.5f;
+  const float gateKnob = self->p_gate       ? clampf(*self->p_gate,       0.0f, 1.0f)  : 0.0f;
+  const float sizeK    = self->p_size       ? clampf(*self->p_size,       SIZE_KNOB_MIN, SIZE_KNOB_MAX) : 1.0f;
+  const float dt = (float)n_samples / fs;
+
+  // At short RT60 the diffusion allpasses ring longer than the combs
+  int ap_len = 0;
+  for (int i = 0; i < NUM_ALLPASSES; ++i) {
+    ap_len += (self->apL[i].D > self->apR[i].D) ? self->apL[i].D : self->apR[i].D;
+  }
+  const float decay = maxf(rt60, -3.0f * (float)ap_len / (fs * dsp_log10f(self->apL[0].a)));
+
+  // Rises at once, falls with the tank (smoothed over the chunks' noise)
+  const float a = dsp_expf(-dt / TAIL_SMOOTH);
+  self->tail_env = maxf(tank_ms, a * self->tail_env + (1.0f - a) * tank_ms);
+  if (in_peak >= SILENCE_FLOOR) {
+    int D = 0;
+    for (int i = 0; i < NUM_COMBS; ++i) {
+      if (self->combL[i].D > D) D = self->combL[i].D;
+      if (self->combR[i].D > D) D = self->combR[i].D;
+    }
+    self->tail_in = maxf(self->tail_in, in_peak);
+    self->tail_hold = 0.001f * input_knobs(self).pre_ms + maxf((float)D / fs, 0.001f * ER_SPAN_MS * sizeK);
+  } else {
+    self->tail_hold = maxf(self->tail_hold - dt, 0.0f);
+    if (self->tail_hold == 0.0f) self->tail_in = 0.0f;
+  }
+
+  // The wet path reaches the output scaled by mix; a gate closes the tank
+  // well before the floor once the tail drops under its hysteresis point
+  float quiet = SILENCE_FLOOR / maxf(mix, 1e-6f);
+  if (gateKnob > 0.0001f) quiet = maxf(quiet, 0.7f * dsp_exp10f((-60.0f + 60.0f * gateKnob) / 20.0f));
+  const float level = maxf(TAIL_CREST * sqrtf(self->tail_env), self->tail_in);
+  self->tail_seconds = self->tail_hold;
+  if (level > quiet) self->tail_seconds += decay / 3.0f * dsp_log10f(level / quiet);
+}
+
+// Value reported on the tail port and by plateverb_tail_seconds(); the
+// parallel engine's output lags the tank by one frame
+static inline float tail_report(const PlateVerb* self) {
+#ifdef PLATEVERB_PARALLEL
+  return (self->par_tail > 0.0f) ? self->par_tail + (float)PLATEVERB_PARALLEL / self->sample_rate : 0.0f;
+#else
+  return self->tail_seconds;
+#endif
+}
+
+// ----- Tank Stage (Combs -> Modulated Allpass -> Gate -> Mix) -----
+static FORCE_INLINE void run_tank(PlateVerb* self, const float fs, const float* in, const float* wet, float* outL, float* outR, uint32_t n_samples) {
   // Controls
   const float mix     = self->p_mix         ? clampf(*self->p_mix,         0.0f, 1.0f)   : 0.25f;
-  const float pre_ms  = self->p_predelay_ms ? clampf(*self->p_predelay_ms, 0.0f, 200.0f) : 20.0f;
   const float rt60    = self->p_decay_rt60  ? clampf(*self->p_decay_rt60,  0.1f, 20.0f)  : 2.5f;
   const float damp    = self->p_damping     ? clampf(*self->p_damping,     0.0f, 1.0f)   : 0.5f;
   const float diff    = self->p_diffusion   ? clampf(*self->p_diffusion,   0.0f, 1.0f)   : 0.7f;
-  const float sizeK   = self->p_size        ? clampf(*self->p_size,        0.5f, 1.5f)   : 1.0f;
+  const float sizeK   = self->p_size        ? clampf(*self->p_size,        SIZE_KNOB_MIN, SIZE_KNOB_MAX) : 1.0f;
   const float gateKnob= self->p_gate        ? clampf(*self->p_gate,        0.0f, 1.0f)   : 0.0f;
   const float modDepth= self->p_mod_depth   ? clampf(*self->p_mod_depth,   0.0f, 5.0f)   : 1.0f;
   const float modRate = self->p_mod_rate    ? clampf(*self->p_mod_rate,    0.0f, 5.0f)   : 0.5f;
-  const float hp_freq = self->p_locut       ? clampf(*self->p_locut,       10.0f, 1000.0f) : 10.0f;
-  const float grit    = self->p_grit        ? clampf(*self->p_grit,        0.0f, 1.0f)   : 0.0f;
-
-  const float dt = 1.0f / self->sample_rate;
-  const float rc_hp = 1.0f / (6.2831853f * hp_freq); 
-  const float hp_alpha = rc_hp / (rc_hp + dt);
-
-  int pred_samp = (int)lrintf(pre_ms * 0.001f * self->sample_rate);
-  if (pred_samp >= self->predelay.size) pred_samp = self->predelay.size - 1;
-
-  // Grit Pre-calculation: 1.0 (clean) to 12.0 (heavily boosted)
-  const float drive_gain = 1.0f + (grit * 11.0f);
 
   const float ap_a = 0.3f + 0.55f * diff;
+  const int ap_headroom = MAX_MS(MOD_MAX_MS, fs);
   for (int i = 0; i < NUM_ALLPASSES; ++i) {
     self->apL[i].a = ap_a; self->apR[i].a = ap_a;
     int DL = (int)lrintf((float)self->baseApL[i] * sizeK);
     int DR = (int)lrintf((float)self->baseApR[i] * sizeK);
-    if (DL >= self->apL[i].delay.size - 250) DL = self->apL[i].delay.size - 250;
-    if (DR >= self->apR[i].delay.size - 250) DR = self->apR[i].delay.size - 250;
+    if (DL >= self->apL[i].delay.size - ap_headroom) DL = self->apL[i].delay.size - ap_headroom;
+    if (DR >= self->apR[i].delay.size - ap_headroom) DR = self->apR[i].delay.size - ap_headroom;
     self->apL[i].D = DL; self->apR[i].D = DR;
   }
   const float lp_a = 0.5f + 0.48f * damp;
@@ -325,80 +1557,178 @@ static void run(LV2_Handle instance, uint32_t n_samples) {
     if (DL >= self->combL[i].delay.size) DL = self->combL[i].delay.size - 1;
     if (DR >= self->combR[i].delay.size) DR = self->combR[i].delay.size - 1;
     self->combL[i].D = DL; self->combR[i].D = DR;
-    self->combL[i].feedback = comb_gain_from_rt60(rt60, DL, self->sample_rate);
-    self->combR[i].feedback = comb_gain_from_rt60(rt60, DR, self->sample_rate);
+    self->combL[i].feedback = comb_gain_from_rt60(rt60, DL, fs);
+    self->combR[i].feedback = comb_gain_from_rt60(rt60, DR, fs);
     self->combL[i].lp.a = lp_a; self->combR[i].lp.a = lp_a;
   }
 
   // Gate Constants
   const int gate_enabled = (gateKnob > 0.0001f) ? 1 : 0;
   const float gate_dB = -60.0f + 60.0f * gateKnob;
-  const float gate_thr = gate_enabled ? powf(10.0f, gate_dB / 20.0f) : 0.0f;
-  const float ea = expf(-1.0f / (self->sample_rate * 0.003f));
-  const float er = expf(-1.0f / (self->sample_rate * 0.050f));
-  const float ga = expf(-1.0f / (self->sample_rate * 0.002f));
-  const float gr = expf(-1.0f / (self->sample_rate * 0.020f));
+  const float gate_thr = gate_enabled ? dsp_exp10f(gate_dB / 20.0f) : 0.0f;
+  const float ea = dsp_expf(-1.0f / (fs * 0.003f));
+  const float er = dsp_expf(-1.0f / (fs * 0.050f));
+  const float ga = dsp_expf(-1.0f / (fs * 0.002f));
+  const float gr = dsp_expf(-1.0f / (fs * 0.020f));
 
-  const float lfo_inc = (modRate * 6.2831853f) / self->sample_rate;
-  const float mod_samp = modDepth * 0.001f * self->sample_rate;
+  const float lfo_inc = (modRate * 6.2831853f) / fs;
+  const float mod_samp = modDepth * 0.001f * fs;
+  static const float ap_pol[NUM_ALLPASSES] = { PLATEVERB_ALLPASSES(PLATEVERB_AP_POL_) };
+  const float comb_scale = 1.0f / (float)NUM_COMBS;
 
-  for (uint32_t n = 0; n < n_samples; ++n) {
-    const float x = in ? in[n] : 0.0f;
+  // Tier swap crossfade: sample n weighs the current taps by xfade_w(n) and
+  // the taps from before the swap by the rest. Combs blend the two reads;
+  // the allpasses, already read at moving fractional taps, glide between them.
+  const int xfade = self->xfade_left > 0;
+  const float xf_w0 = (float)(TIER_XFADE - self->xfade_left) / (float)TIER_XFADE;
+  const float xf_dw = 1.0f / (float)TIER_XFADE;
+#define xfade_w(n) minf(xf_w0 + (float)((n) + 1) * xf_dw, 1.0f)
 
-    // 1. Predelay
-    delay_write(&self->predelay, x); 
-    float predWet = delay_read(&self->predelay, pred_samp + 1);
+  // 4a. Block combs: when every comb delay spans the chunk, all of the
+  // chunk's reads come before its writes. Read and damp whole blocks now;
+  // the writes wait until the gate has produced its per-sample gains.
+  int comb_block = 1;
+  for (int i = 0; i < NUM_COMBS; ++i) {
+    if (self->combL[i].D < (int)n_samples || self->combR[i].D < (int)n_samples) comb_block = 0;
+    if (xfade && (self->xfadeCombL[i] < (int)n_samples || self->xfadeCombR[i] < (int)n_samples)) comb_block = 0;
+  }
+  if (comb_block) {
+    iir1_set(&self->damp_coefs, lp_a);
+    memset(self->sumL, 0, n_samples * sizeof(float));
+    memset(self->sumR, 0, n_samples * sizeof(float));
+    for (int i = 0; i < NUM_COMBS; ++i) {
+      Comb* cl = &self->combL[i];
+      Comb* cr = &self->combR[i];
+      float* zl = self->combZL[i];
+      float* zr = self->combZR[i];
+      delay_read_block(&cl->delay, cl->D, zl, n_samples);
+      delay_read_block(&cr->delay, cr->D, zr, n_samples);
+      if (xfade) {
+        delay_read_block(&cl->delay, self->xfadeCombL[i], self->apTmp, n_samples);
+        for (uint32_t n = 0; n < n_samples; ++n) zl[n] = self->apTmp[n] + xfade_w(n) * (zl[n] - self->apTmp[n]);
+        delay_read_block(&cr->delay, self->xfadeCombR[i], self->apTmp, n_samples);
+        for (uint32_t n = 0; n < n_samples; ++n) zr[n] = self->apTmp[n] + xfade_w(n) * (zr[n] - self->apTmp[n]);
+      }
+      for (uint32_t n = 0; n < n_samples; ++n) {
+        self->sumL[n] += zl[n];
+        self->sumR[n] += zr[n];
+        zl[n] *= (1.0f - lp_a);
+        zr[n] *= (1.0f - lp_a);
+      }
+      iir1_block(&self->damp_coefs, zl, zl, n_samples, &cl->lp.z);
+      iir1_block(&self->damp_coefs, zr, zr, n_samples, &cr->lp.z);
+    }
+  }
 
-    // 2. High Pass Filter
-    float hp_out = hp_alpha * (self->hp_out_z + predWet - self->hp_in_z);
-    self->hp_in_z = predWet;
-    self->hp_out_z = hp_out;
-    predWet = hp_out;
+  if (comb_block) {
+    for (uint32_t n = 0; n < n_samples; ++n) {
+      self->sumL[n] *= comb_scale;
+      self->sumR[n] *= comb_scale;
+    }
 
-    // 3. NEW: Grit (Input Saturation)
-    // Apply boost and soft clip *before* filling the tank
-    if (grit > 0.001f) {
-        predWet = soft_clip(predWet * drive_gain);
+    // 5. Modulated Allpass, one stage at a time over the whole block
+    if (self->quality == QUALITY_FULL) {
+      for (uint32_t n = 0; n < n_samples; ++n) {
+        self->lfo_phase += lfo_inc;
+        if (self->lfo_phase > 6.2831853f) self->lfo_phase -= 6.2831853f;
+        self->lfoS[n] = dsp_sinf(self->lfo_phase);
+        self->lfoC[n] = dsp_cosf(self->lfo_phase);
+      }
+      for (int i = 0; i < NUM_ALLPASSES; ++i) {
+        const float depth = mod_samp * ap_pol[i];
+        int minL = allpass_positions(&self->apL[i], self->lfoS, depth, self->apPos, n_samples);
+        if (xfade) minL = allpass_glide(&self->apL[i], self->xfadeApL[i], xf_w0, xf_dw, self->apPos, n_samples);
+        allpass_block(&self->apL[i], self->apPos, minL, self->sumL, self->apTmp, n_samples);
+        int minR = allpass_positions(&self->apR[i], self->lfoC, depth, self->apPos, n_samples);
+        if (xfade) minR = allpass_glide(&self->apR[i], self->xfadeApR[i], xf_w0, xf_dw, self->apPos, n_samples);
+        allpass_block(&self->apR[i], self->apPos, minR, self->sumR, self->apTmp, n_samples);
+      }
+    } else if (xfade) {
+      // Unmodulated, but the taps still glide
+      for (int i = 0; i < NUM_ALLPASSES; ++i) {
+        allpass_positions(&self->apL[i], self->lfoS, 0.0f, self->apPos, n_samples);
+        const int minL = allpass_glide(&self->apL[i], self->xfadeApL[i], xf_w0, xf_dw, self->apPos, n_samples);
+        allpass_block(&self->apL[i], self->apPos, minL, self->sumL, self->apTmp, n_samples);
+        allpass_positions(&self->apR[i], self->lfoC, 0.0f, self->apPos, n_samples);
+        const int minR = allpass_glide(&self->apR[i], self->xfadeApR[i], xf_w0, xf_dw, self->apPos, n_samples);
+        allpass_block(&self->apR[i], self->apPos, minR, self->sumR, self->apTmp, n_samples);
+      }
+    } else {
+      for (int i = 0; i < NUM_ALLPASSES; ++i) {
+        allpass_block_fixed(&self->apL[i], self->sumL, self->apTmp, n_samples);
+        allpass_block_fixed(&self->apR[i], self->sumR, self->apTmp, n_samples);
+      }
     }
+  }
+
+  float in_peak = 0.0f, tank_e = 0.0f;
+  for (uint32_t n = 0; n < n_samples; ++n) {
+    const float x = in ? in[n] : 0.0f;
+    const float predWet = wet[n];
 
-    // 4. Combs
     float fb_modifier = gate_enabled ? self->gate_gain : 1.0f;
-    float sL = 0.0f, sR = 0.0f;
-    for (int i = 0; i < NUM_COMBS; ++i) {
-      sL += comb_process(&self->combL[i], predWet, fb_modifier);
-      sR += comb_process(&self->combR[i], predWet, fb_modifier);
-    }
-    sL *= 0.25f; sR *= 0.25f;
-
-    // 5. Modulated Allpass
-    self->lfo_phase += lfo_inc;
-    if (self->lfo_phase > 6.2831853f) self->lfo_phase -= 6.2831853f;
-    const float lfo_sin = sinf(self->lfo_phase);
-    const float lfo_cos = cosf(self->lfo_phase);
-
-    float yL = sL, yR = sR;
-    for (int i = 0; i < NUM_ALLPASSES; ++i) {
-        float pol = (i % 2 == 0) ? 1.0f : -1.0f;
-        float dL_mod = (float)self->apL[i].D + (lfo_sin * mod_samp * pol);
-        float dR_mod = (float)self->apR[i].D + (lfo_cos * mod_samp * pol);
-        
-        if (dL_mod < 4.0f) dL_mod = 4.0f; if (dR_mod < 4.0f) dR_mod = 4.0f;
-        if (dL_mod > (float)self->apL[i].delay.size - 4.0f) dL_mod = (float)self->apL[i].delay.size - 4.0f;
-        if (dR_mod > (float)self->apR[i].delay.size - 4.0f) dR_mod = (float)self->apR[i].delay.size - 4.0f;
-        
-        float delayedL = delay_read_linear(&self->apL[i].delay, dL_mod);
-        float outL_ap = delayedL - self->apL[i].a * yL;
-        float inL_ap  = yL + self->apL[i].a * outL_ap;
-        delay_write(&self->apL[i].delay, inL_ap);
-        yL = outL_ap;
-
-        float delayedR = delay_read_linear(&self->apR[i].delay, dR_mod);
-        float outR_ap = delayedR - self->apR[i].a * yR;
-        float inR_ap  = yR + self->apR[i].a * outR_ap;
-        delay_write(&self->apR[i].delay, inR_ap);
-        yR = outR_ap;
+    float yL, yR;
+    if (comb_block) {
+      yL = self->sumL[n]; yR = self->sumR[n];
+      self->fb_mod[n] = fb_modifier;
+    } else {
+      // 4. Combs
+      float sL = 0.0f, sR = 0.0f;
+      if (xfade) {
+        const float w = xfade_w(n);
+        for (int i = 0; i < NUM_COMBS; ++i) {
+          sL += comb_process_xfade(&self->combL[i], predWet, fb_modifier, self->xfadeCombL[i], w);
+          sR += comb_process_xfade(&self->combR[i], predWet, fb_modifier, self->xfadeCombR[i], w);
+        }
+      } else {
+        for (int i = 0; i < NUM_COMBS; ++i) {
+          sL += comb_process(&self->combL[i], predWet, fb_modifier);
+          sR += comb_process(&self->combR[i], predWet, fb_modifier);
+        }
+      }
+      sL *= comb_scale; sR *= comb_scale;
+
+      // 5. Modulated Allpass; unmodulated below full quality, as in the
+      // block path, unless a tier crossfade is gliding the taps
+      float lfo_sin = 0.0f, lfo_cos = 0.0f;
+      if (self->quality == QUALITY_FULL) {
+        self->lfo_phase += lfo_inc;
+        if (self->lfo_phase > 6.2831853f) self->lfo_phase -= 6.2831853f;
+        lfo_sin = dsp_sinf(self->lfo_phase);
+        lfo_cos = dsp_cosf(self->lfo_phase);
+      }
+
+      yL = sL; yR = sR;
+      if (self->quality != QUALITY_FULL && !xfade) {
+        for (int i = 0; i < NUM_ALLPASSES; ++i) {
+          yL = allpass_process(&self->apL[i], yL);
+          yR = allpass_process(&self->apR[i], yR);
+        }
+      } else {
+        for (int i = 0; i < NUM_ALLPASSES; ++i) {
+          const float pol = ap_pol[i];
+          float dL_mod = (float)self->apL[i].D + (lfo_sin * mod_samp * pol);
+          float dR_mod = (float)self->apR[i].D + (lfo_cos * mod_samp * pol);
+          if (xfade) {
+            const float w = xfade_w(n);
+            dL_mod += (1.0f - w) * (float)(self->xfadeApL[i] - self->apL[i].D);
+            dR_mod += (1.0f - w) * (float)(self->xfadeApR[i] - self->apR[i].D);
+          }
+
+          if (dL_mod < 4.0f) dL_mod = 4.0f;
+          if (dR_mod < 4.0f) dR_mod = 4.0f;
+          if (dL_mod > (float)self->apL[i].delay.size - 4.0f) dL_mod = (float)self->apL[i].delay.size - 4.0f;
+          if (dR_mod > (float)self->apR[i].delay.size - 4.0f) dR_mod = (float)self->apR[i].delay.size - 4.0f;
+
+          yL = allpass_process_mod(&self->apL[i], yL, dL_mod);
+          yR = allpass_process_mod(&self->apR[i], yR, dR_mod);
+        }
+      }
     }
 
+    in_peak = maxf(in_peak, fabsf(x));
+    tank_e += yL * yL + yR * yR;
+
     // 6. Gate (Stereo Linked)
     if (gate_enabled) {
       const float trigger = maxf(fabsf(yL), fabsf(yR));
@@ -418,21 +1748,545 @@ static void run(LV2_Handle instance, uint32_t n_samples) {
     outL[n] = (1.0f - mix) * x + mix * yL;
     outR[n] = (1.0f - mix) * x + mix * yR;
   }
+
+  // 4b. Block comb writes: input plus damped feedback, scaled by the gate
+  // gain each sample saw.
+  if (comb_block) {
+    for (int i = 0; i < NUM_COMBS; ++i) {
+      Comb* cl = &self->combL[i];
+      Comb* cr = &self->combR[i];
+      float* zl = self->combZL[i];
+      float* zr = self->combZR[i];
+      for (uint32_t n = 0; n < n_samples; ++n) {
+        zl[n] = wet[n] + (cl->feedback * self->fb_mod[n]) * zl[n];
+        zr[n] = wet[n] + (cr->feedback * self->fb_mod[n]) * zr[n];
+      }
+      delay_write_block(&cl->delay, zl, n_samples);
+      delay_write_block(&cr->delay, zr, n_samples);
+    }
+  }
+#undef xfade_w
+  if (xfade) self->xfade_left = (self->xfade_left > (int)n_samples) ? self->xfade_left - (int)n_samples : 0;
+
+  tail_update(self, fs, in_peak, tank_e / (2.0f * (float)n_samples), n_samples);
+}
+
+// ----- Early Reflections -----
+// Sparse multi-tap FIR over the predelay line, which already holds the
+// input history. Tap times are in ms behind the predelay point at Size 1.0.
+#define NUM_ER_TAPS 12
+
+static const float er_ms_L[NUM_ER_TAPS] = {
+  3.1f, 5.3f, 7.9f, 10.7f, 12.9f, 15.4f, 17.8f, 20.6f, 23.3f, 25.1f, 27.7f, 30.2f
+};
+static const float er_ms_R[NUM_ER_TAPS] = {
+  3.7f, 6.1f, 8.3f, 10.1f, 13.6f, 16.2f, 18.5f, 19.9f, 22.4f, 26.0f, 28.9f, 31.6f
+};
+static const float er_gain_L[NUM_ER_TAPS] = {
+  0.62f, -0.55f, 0.50f, 0.44f, -0.40f, 0.35f, -0.31f, 0.27f, 0.24f, -0.21f, 0.18f, -0.16f
+};
+static const float er_gain_R[NUM_ER_TAPS] = {
+  -0.60f, 0.56f, 0.49f, -0.45f, 0.39f, 0.36f, -0.30f, 0.28f, -0.23f, 0.22f, -0.19f, 0.15f
+};
+
+// acc[i] += g * (sample `tap` behind time i), for the n samples just written.
+// Consecutive output samples read consecutive buffer slots, so each tap is a
+// contiguous multiply-add over at most two runs of the ring.
+static inline void er_tap_accumulate(const Delay* d, int tap, float g, float* acc, uint32_t n) {
+  int start = d->idx - tap - (int)n + 1;
+  while (start < 0) start += d->size;
+  const uint32_t first = ((uint32_t)(d->size - start) < n) ? (uint32_t)(d->size - start) : n;
+  const float* src = d->buf + start;
+  for (uint32_t i = 0; i < first; ++i) acc[i] += g * src[i];
+  for (uint32_t i = first; i < n; ++i) acc[i] += g * d->buf[i - first];
+}
+
+// Called after run_input() has written the chunk into `pre` (the group
+// leader's predelay when inputs are shared).
+static FORCE_INLINE void run_early(PlateVerb* self, const float fs, const Delay* pre, float* outL, float* outR, uint32_t n_samples) {
+  const float level = self->p_early ? clampf(*self->p_early, 0.0f, 1.0f) : 0.0f;
+  if (level < 0.0001f || self->quality != QUALITY_FULL) return;
+  const float mix   = self->p_mix  ? clampf(*self->p_mix,  0.0f, 1.0f)                   : 0.25f;
+  const float sizeK = self->p_size ? clampf(*self->p_size, SIZE_KNOB_MIN, SIZE_KNOB_MAX) : 1.0f;
+
+  const InputKnobs k = input_knobs(self);
+  const int pred_samp = (int)lrintf(k.pre_ms * 0.001f * fs);
+  const int max_tap = pre->size - (int)n_samples;
+  const float g = mix * level;
+  const float ms_to_samp = 0.001f * fs * sizeK;
+
+  for (int i = 0; i < NUM_ER_TAPS; ++i) {
+    int tL = pred_samp + 1 + (int)lrintf(er_ms_L[i] * ms_to_samp);
+    int tR = pred_samp + 1 + (int)lrintf(er_ms_R[i] * ms_to_samp);
+    if (tL > max_tap) tL = max_tap;
+    if (tR > max_tap) tR = max_tap;
+    er_tap_accumulate(pre, tL, g * er_gain_L[i], outL, n_samples);
+    er_tap_accumulate(pre, tR, g * er_gain_R[i], outR, n_samples);
+  }
+}
+
+// ----- Idle Bypass -----
+static inline float block_peak(const float* x, uint32_t n) {
+  float peak = 0.0f;
+  for (uint32_t i = 0; x && i < n; ++i) peak = maxf(peak, fabsf(x[i]));
+  return peak;
+}
+
+// Dry path only; the tank and predelay are left as they are (already silent).
+static inline void run_dry(const PlateVerb* self, const float* in, float* outL, float* outR, uint32_t n_samples) {
+  const float mix = self->p_mix ? clampf(*self->p_mix, 0.0f, 1.0f) : 0.25f;
+  for (uint32_t n = 0; n < n_samples; ++n) {
+    const float x = in ? in[n] : 0.0f;
+    outL[n] = (1.0f - mix) * x;
+    outR[n] = (1.0f - mix) * x;
+  }
+}
+
+// `fs` is a parameter so that the fixed-rate build can instantiate this body
+// with a literal rate: every rate-derived constant then folds at compile time.
+static FORCE_INLINE void run_chunks(PlateVerb* self, const float fs, uint32_t n_samples) {
+  const float* in = self->in;
+  for (uint32_t off = 0; off < n_samples; off += BLOCK_LEN) {
+    const uint32_t n = (n_samples - off < BLOCK_LEN) ? (n_samples - off) : BLOCK_LEN;
+    if (self->quality == QUALITY_IDLE && block_peak(in ? in + off : NULL, n) < SILENCE_FLOOR) {
+      run_dry(self, in ? in + off : NULL, self->out_l + off, self->out_r + off, n);
+      tail_update(self, fs, 0.0f, 0.0f, n);
+      continue;
+    }
+    run_input(self, fs, in ? in + off : NULL, self->wet, n);
+    run_tank(self, fs, in ? in + off : NULL, self->wet, self->out_l + off, self->out_r + off, n);
+    run_early(self, fs, &self->predelay, self->out_l + off, self->out_r + off, n);
+    self->tank_frames += n;
+  }
+}
+
+// Process n_samples from self->in into self->out_l/out_r
+static void run_kernel(PlateVerb* self, uint32_t n_samples) {
+#ifdef PLATEVERB_CPU_BUDGET
+  const double t0 = budget_clock();
+  const float peak = block_peak(self->in, n_samples);
+#endif
+
+#ifdef PLATEVERB_FIXED_RATE
+  // Specialised kernel, only when the host actually runs at the build rate
+  if (self->sample_rate == (float)PLATEVERB_FIXED_RATE) {
+    run_chunks(self, (float)PLATEVERB_FIXED_RATE, n_samples);
+  } else
+#endif
+  run_chunks(self, self->sample_rate, n_samples);
+
+#ifdef PLATEVERB_CPU_BUDGET
+  budget_update(self, peak, budget_clock() - t0, n_samples);
+#endif
+}
+
+static void run(LV2_Handle instance, uint32_t n_samples) {
+  PlateVerb* self = (PlateVerb*)instance;
+#ifdef PLATEVERB_PARALLEL
+  float* latency = (float*)self->host[PLATEVERB_LATENCY];
+  if (latency) *latency = (float)PLATEVERB_PARALLEL;
+  par_run(self, n_samples);
+  float* tail = (float*)self->host[PLATEVERB_TAIL];
+  if (tail) *tail = tail_report(self);
+#else
+  tier_update(self, self->p_size ? clampf(*self->p_size, SIZE_KNOB_MIN, SIZE_KNOB_MAX) : 1.0f);
+  if (self->p_latency) *self->p_latency = 0.0f;
+  run_kernel(self, n_samples);
+  if (self->p_tail) *self->p_tail = tail_report(self);
+#endif
 }
 
 static void deactivate(LV2_Handle instance) { (void)instance; }
 static void cleanup(LV2_Handle instance) {
   PlateVerb* self = (PlateVerb*)instance;
-  // Cleanup logic same as before...
-  delay_free(&self->predelay);
-  for (int i = 0; i < NUM_COMBS; ++i) { comb_free(&self->combL[i]); comb_free(&self->combR[i]); }
-  for (int i = 0; i < NUM_ALLPASSES; ++i) { allpass_free(&self->apL[i]); allpass_free(&self->apR[i]); }
+#ifdef PLATEVERB_PARALLEL
+  par_quiesce(self);
+  par_leave(self);
+#endif
+#ifdef PLATEVERB_CPU_BUDGET
+  budget_leave(self->budget_slot);
+#endif
+  arena_release(self->arena);
+  arena_release(self->retired);
   free(self);
 }
-static const void* extension_data(const char* uri) { (void)uri; return NULL; }
+static const void* extension_data(const char* uri) {
+  if (!strcmp(uri, LV2_WORKER__interface)) return &worker_iface;
+  return NULL;
+}
 static const LV2_Descriptor descriptor = {
   PLATEVERB_URI, instantiate, connect_port, activate, run, deactivate, cleanup, extension_data
 };
 LV2_SYMBOL_EXPORT const LV2_Descriptor* lv2_descriptor(uint32_t index) {
   switch (index) { case 0: return &descriptor; default: return NULL; }
-}
\ No newline at end of file
+}
+
+// ----- Embedding API -----
+static const struct {
+  const char* symbol;
+  float def;
+} port_info[PLATEVERB_NUM_PORTS] = {
+  { "in",           0.0f },
+  { "out_l",        0.0f },
+  { "out_r",        0.0f },
+  { "mix",          0.25f },
+  { "predelay_ms",  20.0f },
+  { "decay_rt60",   2.5f },
+  { "damping",      0.5f },
+  { "diffusion",    0.7f },
+  { "size",         1.0f },
+  { "gate",         0.0f },
+  { "mod_depth",    1.0f },
+  { "mod_rate",     0.5f },
+  { "locut",        10.0f },
+  { "grit",         0.0f },
+  { "early",        0.0f },
+  { "latency",      0.0f },
+  { "tail",         0.0f },
+};
+
+PlateVerb* plateverb_new(double sample_rate) {
+  PlateVerb* self = (PlateVerb*)instantiate(&descriptor, sample_rate, NULL, NULL);
+  if (!self) return NULL;
+  for (int p = PLATEVERB_MIX; p < PLATEVERB_NUM_PORTS; ++p) {
+    self->controls[p] = port_info[p].def;
+    connect_port(self, (uint32_t)p, &self->controls[p]);
+  }
+  activate(self);
+  return self;
+}
+
+void plateverb_free(PlateVerb* pv) {
+  if (pv) cleanup(pv);
+}
+
+void plateverb_reset(PlateVerb* pv) { activate(pv); }
+
+int plateverb_port_index(const char* symbol) {
+  if (!symbol) return -1;
+  for (int p = 0; p < PLATEVERB_NUM_PORTS; ++p) {
+    if (strcmp(symbol, port_info[p].symbol) == 0) return p;
+  }
+  return -1;
+}
+
+const char* plateverb_port_symbol(int port) {
+  return (port >= 0 && port < PLATEVERB_NUM_PORTS) ? port_info[port].symbol : NULL;
+}
+
+void plateverb_set(PlateVerb* pv, int port, float value) {
+  if (port >= PLATEVERB_MIX && port < PLATEVERB_LATENCY) pv->controls[port] = value;
+}
+
+float plateverb_get(const PlateVerb* pv, int port) {
+  return (port >= PLATEVERB_MIX && port < PLATEVERB_LATENCY) ? pv->controls[port] : 0.0f;
+}
+
+void plateverb_process(PlateVerb* pv, const float* in, float* out_l, float* out_r, uint32_t n_samples) {
+  connect_port(pv, PLATEVERB_IN, (void*)in);
+  connect_port(pv, PLATEVERB_OUT_L, out_l);
+  connect_port(pv, PLATEVERB_OUT_R, out_r);
+  run(pv, n_samples);
+}
+
+static int same_input_group(const PlateVerb* a, const PlateVerb* b) {
+  const InputKnobs ka = input_knobs(a);
+  const InputKnobs kb = input_knobs(b);
+  return a->sample_rate == b->sample_rate && ka.pre_ms == kb.pre_ms
+      && ka.hp_freq == kb.hp_freq && ka.grit == kb.grit;
+}
+
+void plateverb_process_multi(PlateVerb* const* pvs, uint32_t count, const float* in,
+                             float* const* out_l, float* const* out_r, uint32_t n_samples) {
+#ifdef PLATEVERB_PARALLEL
+  // This path runs synchronously: settle frames in flight, take controls now
+  for (uint32_t k = 0; k < count; ++k) {
+    par_quiesce(pvs[k]);
+    par_snapshot(pvs[k]);
+  }
+#endif
+  for (uint32_t k = 0; k < count; ++k) {
+    // Only group leaders (first instance with a given input tuple) start a pass
+    int leader = 1;
+    for (uint32_t j = 0; j < k && leader; ++j) leader = !same_input_group(pvs[j], pvs[k]);
+    if (!leader) continue;
+
+    PlateVerb* lead = pvs[k];
+    for (uint32_t off = 0; off < n_samples; off += BLOCK_LEN) {
+      const uint32_t n = (n_samples - off < BLOCK_LEN) ? (n_samples - off) : BLOCK_LEN;
+      run_input(lead, lead->sample_rate, in ? in + off : NULL, lead->wet, n);
+      for (uint32_t m = k; m < count; ++m) {
+        if (m != k && !same_input_group(lead, pvs[m])) continue;
+        run_tank(pvs[m], lead->sample_rate, in ? in + off : NULL, lead->wet, out_l[m] + off, out_r[m] + off, n);
+        run_early(pvs[m], lead->sample_rate, &lead->predelay, out_l[m] + off, out_r[m] + off, n);
+      }
+    }
+    for (uint32_t m = k + 1; m < count; ++m) {
+      if (same_input_group(lead, pvs[m])) copy_input_state(pvs[m], lead, n_samples);
+    }
+  }
+#ifdef PLATEVERB_PARALLEL
+  for (uint32_t k = 0; k < count; ++k) pvs[k]->par_tail = pvs[k]->tail_seconds;
+#endif
+}
+
+void plateverb_process_batch(PlateVerb* const* pvs, uint32_t count, const float* const* in,
+                             float* const* out_l, float* const* out_r, uint32_t n_samples) {
+#ifdef PLATEVERB_PARALLEL
+  // Between frames the job of the frame being filled is free: queue it on
+  // the caller's buffers for every instance, then join them all. The
+  // joining thread steals whatever the workers have not started.
+  for (uint32_t k = 0; k < count; ++k) {
+    PlateVerb* pv = pvs[k];
+    par_quiesce(pv);
+    const float* size = (const float*)pv->host[PLATEVERB_SIZE];
+    tier_update(pv, size ? clampf(*size, SIZE_KNOB_MIN, SIZE_KNOB_MAX) : 1.0f);
+    if (pv->par_pos == 0) par_submit(pv, &pv->jobs[pv->par_cur], in[k], out_l[k], out_r[k], n_samples);
+  }
+  for (uint32_t k = 0; k < count; ++k) {
+    PlateVerb* pv = pvs[k];
+    ParallelJob* job = &pv->jobs[pv->par_cur];
+    if (pv->par_pos == 0) {
+      par_wait(job);
+      pv->par_tail = job->tail;
+    } else {
+      // Caught mid-frame by plateverb_process(): run it here instead
+      par_snapshot(pv);
+      pv->in = in[k];
+      pv->out_l = out_l[k];
+      pv->out_r = out_r[k];
+      run_kernel(pv, n_samples);
+      pv->par_tail = pv->tail_seconds;
+    }
+  }
+#else
+  for (uint32_t k = 0; k < count; ++k) plateverb_process(pvs[k], in[k], out_l[k], out_r[k], n_samples);
+#endif
+}
+
+float plateverb_tail_seconds(const PlateVerb* pv) { return tail_report(pv); }
+
+// ----- State Checkpoints -----
+// Layout: StateHeader, one write index per delay line (tier_layout order),
+// then the filter, LFO, gate and tail-estimate scalars followed by every
+// line's contents.
+// Lines are stored without their placement padding, so a state does not
+// depend on where an arena happens to sit in memory (see tier_offsets).
+#define STATE_MAGIC    0x54535650u   // "PVST"
+#define STATE_VERSION  3
+#define STATE_SCALARS  (9 + 2 * NUM_COMBS)
+#ifdef PLATEVERB_PARALLEL
+#define STATE_PAR_INTS    2
+#define STATE_PAR_FLOATS  (2 * 3 * PLATEVERB_PARALLEL + 1)
+#else
+#define STATE_PAR_INTS    0
+#define STATE_PAR_FLOATS  0
+#endif
+#define STATE_INTS     (ARENA_LINES + STATE_PAR_INTS)
+
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  float sample_rate;
+  int32_t tier;
+  uint32_t n_ints;
+  uint32_t n_floats;
+} StateHeader;
+
+static StateHeader state_header(const PlateVerb* self) {
+  const Delay* lines[ARENA_LINES];
+  tank_lines(self, lines);
+  StateHeader h = { STATE_MAGIC, STATE_VERSION, self->sample_rate, self->tier, STATE_INTS, STATE_SCALARS + STATE_PAR_FLOATS };
+  for (int k = 0; k < ARENA_LINES; ++k) h.n_floats += (uint32_t)lines[k]->size;
+  return h;
+}
+
+size_t plateverb_state_size(const PlateVerb* pv) {
+  const StateHeader h = state_header(pv);
+  return sizeof(h) + h.n_ints * sizeof(int32_t) + h.n_floats * sizeof(float);
+}
+
+size_t plateverb_state_save(PlateVerb* pv, void* buf, size_t size) {
+  const size_t bytes = plateverb_state_size(pv);
+  if (size < bytes) return 0;
+#ifdef PLATEVERB_PARALLEL
+  par_quiesce(pv);
+#endif
+  const StateHeader h = state_header(pv);
+  const Delay* lines[ARENA_LINES];
+  tank_lines(pv, lines);
+  uint8_t* p = (uint8_t*)buf;
+  memcpy(p, &h, sizeof(h));
+  p += sizeof(h);
+
+  int32_t ints[STATE_INTS];
+  for (int k = 0; k < ARENA_LINES; ++k) ints[k] = lines[k]->idx;
+#ifdef PLATEVERB_PARALLEL
+  ints[ARENA_LINES] = pv->par_cur;
+  ints[ARENA_LINES + 1] = (int32_t)pv->par_pos;
+#endif
+  memcpy(p, ints, sizeof(ints));
+  p += sizeof(ints);
+
+  float sc[STATE_SCALARS] = { pv->lfo_phase, pv->hp_in_z, pv->hp_out_z, pv->gate_env, pv->gate_gain,
+                              pv->tail_env, pv->tail_in, pv->tail_hold, pv->tail_seconds };
+  for (int i = 0; i < NUM_COMBS; ++i) {
+    sc[9 + 2 * i] = pv->combL[i].lp.z;
+    sc[10 + 2 * i] = pv->combR[i].lp.z;
+  }
+  memcpy(p, sc, sizeof(sc));
+  p += sizeof(sc);
+#ifdef PLATEVERB_PARALLEL
+  for (int j = 0; j < 2; ++j) {
+    memcpy(p, pv->jobs[j].in, sizeof(pv->jobs[j].in));       p += sizeof(pv->jobs[j].in);
+    memcpy(p, pv->jobs[j].out_l, sizeof(pv->jobs[j].out_l)); p += sizeof(pv->jobs[j].out_l);
+    memcpy(p, pv->jobs[j].out_r, sizeof(pv->jobs[j].out_r)); p += sizeof(pv->jobs[j].out_r);
+  }
+  memcpy(p, &pv->par_tail, sizeof(pv->par_tail));
+  p += sizeof(pv->par_tail);
+#endif
+  for (int k = 0; k < ARENA_LINES; ++k) {
+    memcpy(p, lines[k]->buf, (size_t)lines[k]->size * sizeof(float));
+    p += (size_t)lines[k]->size * sizeof(float);
+  }
+  return bytes;
+}
+
+int plateverb_state_restore(PlateVerb* pv, const void* buf, size_t size) {
+  const StateHeader want = state_header(pv);
+  StateHeader h;
+  if (size != plateverb_state_size(pv)) return -1;
+  memcpy(&h, buf, sizeof(h));
+  if (memcmp(&h, &want, sizeof(h)) != 0) return -1;
+#ifdef PLATEVERB_PARALLEL
+  par_quiesce(pv);
+#endif
+  const Delay* lines[ARENA_LINES];
+  tank_lines(pv, lines);
+  const uint8_t* p = (const uint8_t*)buf + sizeof(h);
+
+  int32_t ints[STATE_INTS];
+  memcpy(ints, p, sizeof(ints));
+  p += sizeof(ints);
+  for (int k = 0; k < ARENA_LINES; ++k) {
+    if (ints[k] < 0 || ints[k] >= lines[k]->size) return -1;
+  }
+#ifdef PLATEVERB_PARALLEL
+  if ((ints[ARENA_LINES] & ~1) || ints[ARENA_LINES + 1] < 0 || ints[ARENA_LINES + 1] >= PLATEVERB_PARALLEL) return -1;
+  pv->par_cur = ints[ARENA_LINES];
+  pv->par_pos = (uint32_t)ints[ARENA_LINES + 1];
+#endif
+  for (int k = 0; k < ARENA_LINES; ++k) ((Delay*)lines[k])->idx = ints[k];
+
+  float sc[STATE_SCALARS];
+  memcpy(sc, p, sizeof(sc));
+  p += sizeof(sc);
+  pv->lfo_phase = sc[0];
+  pv->hp_in_z = sc[1];
+  pv->hp_out_z = sc[2];
+  pv->gate_env = sc[3];
+  pv->gate_gain = sc[4];
+  pv->tail_env = sc[5];
+  pv->tail_in = sc[6];
+  pv->tail_hold = sc[7];
+  pv->tail_seconds = sc[8];
+  for (int i = 0; i < NUM_COMBS; ++i) {
+    pv->combL[i].lp.z = sc[9 + 2 * i];
+    pv->combR[i].lp.z = sc[10 + 2 * i];
+  }
+#ifdef PLATEVERB_PARALLEL
+  for (int j = 0; j < 2; ++j) {
+    memcpy(pv->jobs[j].in, p, sizeof(pv->jobs[j].in));       p += sizeof(pv->jobs[j].in);
+    memcpy(pv->jobs[j].out_l, p, sizeof(pv->jobs[j].out_l)); p += sizeof(pv->jobs[j].out_l);
+    memcpy(pv->jobs[j].out_r, p, sizeof(pv->jobs[j].out_r)); p += sizeof(pv->jobs[j].out_r);
+  }
+  memcpy(&pv->par_tail, p, sizeof(pv->par_tail));
+  p += sizeof(pv->par_tail);
+#endif
+  for (int k = 0; k < ARENA_LINES; ++k) {
+    memcpy(lines[k]->buf, p, (size_t)lines[k]->size * sizeof(float));
+    p += (size_t)lines[k]->size * sizeof(float);
+  }
+  return 0;
+}
+
+// Largest of d and the differences between n floats at a and b
+static float state_diff(const uint8_t* a, const uint8_t* b, size_t n, float d) {
+  for (size_t i = 0; i < n; ++i) {
+    float x, y;
+    memcpy(&x, a + i * sizeof(float), sizeof(float));
+    memcpy(&y, b + i * sizeof(float), sizeof(float));
+    const float e = fabsf(x - y);
+    if (!(e <= d)) d = e;   // NaN is never close
+  }
+  return d;
+}
+
+// Only audio is compared: the filter states, the parallel frame buffers
+// and the delay lines. The LFO phase, the gate envelope and the tail
+// estimate are not samples, and would hold the distance up long after the
+// sound has converged (the tail estimate is in seconds).
+float plateverb_state_distance(const void* a, const void* b, size_t size) {
+  const size_t fixed = sizeof(StateHeader) + STATE_INTS * sizeof(int32_t);
+  const size_t scalars = STATE_SCALARS * sizeof(float);
+  const size_t par = STATE_PAR_FLOATS * sizeof(float);
+  if (size < fixed + scalars + par || memcmp(a, b, fixed) != 0) return INFINITY;
+  const uint8_t* pa = (const uint8_t*)a + fixed;
+  const uint8_t* pb = (const uint8_t*)b + fixed;
+  float d = state_diff(pa + 1 * sizeof(float), pb + 1 * sizeof(float), 2, 0.0f);   // hp_in_z, hp_out_z
+  d = state_diff(pa + 9 * sizeof(float), pb + 9 * sizeof(float), 2 * NUM_COMBS, d); // comb lowpasses
+  pa += scalars;
+  pb += scalars;
+#ifdef PLATEVERB_PARALLEL
+  d = state_diff(pa, pb, STATE_PAR_FLOATS - 1, d);   // frame buffers, not par_tail
+#endif
+  pa += par;
+  pb += par;
+  return state_diff(pa, pb, (size - fixed - scalars - par) / sizeof(float), d);
+}
+
+#ifdef PLATEVERB_SELFTEST
+// ----- Self Test -----
+// The block kernels against their sequential definitions, on random input
+// (bench --check). iir1_block() regroups the recurrence, so it is compared
+// with a tolerance: error relative to the block's peak output.
+#define IIR1_TOLERANCE 1e-5f
+
+static float selftest_rand(uint32_t* s) {
+  *s = *s * 1664525u + 1013904223u;
+  return (float)(int32_t)*s * (1.0f / 2147483648.0f);   // [-1, 1)
+}
+
+int plateverb_selftest(float* iir1_error) {
+  // Damping coefficients span the low end, the HPF's sit just below 1
+  static const float coefs[] = { 0.0f, 0.3f, 0.75f, 0.95f, 0.999f, 0.99995f };
+  float u[259], y[259];   // not a multiple of four: the scalar tail runs too
+  uint32_t s = 1;
+  float worst = 0.0f;
+  for (size_t c = 0; c < sizeof(coefs) / sizeof(coefs[0]); ++c) {
+    IIR1Coefs k = { { 0.0f, 0.0f, 0.0f, 0.0f } };
+    iir1_set(&k, coefs[c]);
+    for (int trial = 0; trial < 64; ++trial) {
+      const uint32_t n = 1 + (uint32_t)((selftest_rand(&s) * 0.5f + 0.5f) * 258.0f);
+      const float z0 = selftest_rand(&s);
+      for (uint32_t i = 0; i < n; ++i) u[i] = selftest_rand(&s);
+      float ref = z0, peak = fabsf(z0), err = 0.0f;
+      float state = z0;
+      memcpy(y, u, n * sizeof(float));
+      iir1_block(&k, y, y, n, &state);   // in place, as the DSP calls it
+      for (uint32_t i = 0; i < n; ++i) {
+        ref = u[i] + coefs[c] * ref;
+        if (fabsf(ref) > peak) peak = fabsf(ref);
+        const float e = fabsf(y[i] - ref);
+        if (!(e <= err)) err = e;
+      }
+      const float e = fabsf(state - ref);
+      if (!(e <= err)) err = e;
+      err /= (peak > 0.0f) ? peak : 1.0f;
+      if (!(err <= worst)) worst = err;
+    }
+  }
+  if (iir1_error) *iir1_error = worst;
+  return (worst <= IIR1_TOLERANCE) ? 0 : -1;
+}
+#endif
@@ -0,0 +1,114 @@
+// src/plateverb.h
+// Embedding API for the PlateVerb DSP core (Python bindings, offline tools).
+// The LV2 plugin itself does not need this header.
+#ifndef PLATEVERB_H
+#define PLATEVERB_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Port indices, same as plateverb.ttl
+typedef enum {
+  PLATEVERB_IN = 0,
+  PLATEVERB_OUT_L,
+  PLATEVERB_OUT_R,
+  PLATEVERB_MIX,
+  PLATEVERB_PREDELAY_MS,
+  PLATEVERB_DECAY_RT60,
+  PLATEVERB_DAMPING,
+  PLATEVERB_DIFFUSION,
+  PLATEVERB_SIZE,
+  PLATEVERB_GATE,
+  PLATEVERB_MOD_DEPTH,
+  PLATEVERB_MOD_RATE,
+  PLATEVERB_LOCUT,
+  PLATEVERB_GRIT,
+  PLATEVERB_EARLY,
+  PLATEVERB_LATENCY,        // output; outputs follow the controls
+  PLATEVERB_TAIL,           // output, seconds
+  PLATEVERB_NUM_PORTS
+} PlateVerbPort;
+
+typedef struct PlateVerb PlateVerb;
+
+// Create an activated instance with every control at its TTL default.
+// Returns NULL on allocation failure.
+PlateVerb* plateverb_new(double sample_rate);
+void plateverb_free(PlateVerb* pv);
+
+// Clear the tank, predelay, filters and gate (same as LV2 activate()).
+void plateverb_reset(PlateVerb* pv);
+
+// Port index for a TTL symbol ("mix", "decay_rt60", ...), or -1.
+int plateverb_port_index(const char* symbol);
+const char* plateverb_port_symbol(int port);
+
+// Control values (PLATEVERB_MIX through PLATEVERB_EARLY). Out-of-range
+// values are clamped by the DSP, as in LV2. Output ports are not controls:
+// set() ignores them and get() returns 0.
+void plateverb_set(PlateVerb* pv, int port, float value);
+float plateverb_get(const PlateVerb* pv, int port);
+
+// Process n_samples of mono input into stereo output. `in` may alias
+// `out_l` or `out_r`. Separate instances may be processed concurrently
+// from different threads; a single instance must not.
+void plateverb_process(PlateVerb* pv, const float* in, float* out_l, float* out_r, uint32_t n_samples);
+
+// Render one input through `count` instances (e.g. preset variations) in
+// one pass. Instances with equal predelay_ms, locut and grit share a single
+// predelay/HPF/grit stage; only their tanks run separately. The instances
+// should have seen the same input history (typically: freshly reset), since
+// followers adopt the input-stage state of their group leader.
+// out_l[k]/out_r[k] receive instance k's output and must not alias `in`.
+void plateverb_process_multi(PlateVerb* const* pvs, uint32_t count, const float* in,
+                             float* const* out_l, float* const* out_r, uint32_t n_samples);
+
+// Process `count` distinct instances, each on its own input, in one call.
+// The parallel build (PARALLEL) spreads them over its worker threads and
+// joins them before returning, so it adds none of the one-frame latency
+// plateverb_process() has there; other builds process them in turn. Per instance the arguments
+// are those of plateverb_process().
+void plateverb_process_batch(PlateVerb* const* pvs, uint32_t count, const float* const* in,
+                             float* const* out_l, float* const* out_r, uint32_t n_samples);
+
+// State checkpoints: every delay line with its write position, the comb
+// damping filters, HPF, LFO phase and gate. Controls are not part of the
+// state; set them again after a restore. A state restores into any
+// instance created at the same sample rate.
+size_t plateverb_state_size(const PlateVerb* pv);
+
+// Write the state to buf. Returns the bytes written, or 0 if size is
+// smaller than plateverb_state_size().
+size_t plateverb_state_save(PlateVerb* pv, void* buf, size_t size);
+
+// Returns 0, or -1 (instance unchanged) if the state does not fit pv.
+int plateverb_state_restore(PlateVerb* pv, const void* buf, size_t size);
+
+// Largest absolute difference between the audio held in two saved states
+// of the same size, or INFINITY if they are not comparable (different
+// sample rate, or taken at different positions of the delay lines).
+// Compared: the delay lines, the HPF and comb damping filter states and,
+// in the parallel build, the frame buffers. Not compared: the LFO phase,
+// the gate envelope and the tail estimate.
+float plateverb_state_distance(const void* a, const void* b, size_t size);
+
+// Estimated seconds until the output falls below -100 dBFS if the input
+// went silent now (also the "tail" output port). Updated every block.
+float plateverb_tail_seconds(const PlateVerb* pv);
+
+#ifdef PLATEVERB_SELFTEST
+// Check the block DSP kernels against their sequential definitions on
+// random input. Returns 0, or -1 if one is out of tolerance; iir1_error
+// (may be NULL) gets the block IIR's worst error relative to its peak.
+int plateverb_selftest(float* iir1_error);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PLATEVERB_H
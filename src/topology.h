@@ -0,0 +1,48 @@
+// src/topology.h
+// Tank constants, as tables only: nothing is generated from this file and
+// there is no build step behind it. The tables set how many combs and
+// allpasses there are, their reference delays and each allpass's modulation
+// polarity; plateverb.c takes its node counts, delay tables, arena line
+// count, comb sum scale and polarities from them. The kernels are written by
+// hand in run_tank() as loops over the node arrays (trip counts are
+// compile-time constants).
+//
+// Node connections are not configurable. run_tank() wires them as:
+//   input -> every comb, in parallel; outputs summed and scaled 1/NUM_COMBS
+//         -> allpasses in table order, in series, LFO-modulated
+//         -> gate -> mix
+// with the left and right columns forming two independent chains.
+// Changing the wiring, or adding node types, means editing run_tank().
+//
+// Delays are in samples at 48 kHz and scale with sample rate and Size.
+// `make check-regress` compares reference renders against a recorded
+// digest, and `make bench` times the presets (both in tools/bench.c).
+#ifndef PLATEVERB_TOPOLOGY_H
+#define PLATEVERB_TOPOLOGY_H
+
+// X(left, right): one feedback comb per side
+#define PLATEVERB_COMBS(X) \
+  X(1201, 1319)            \
+  X(1553, 1613)            \
+  X(1867, 1973)            \
+  X(2203, 2411)
+
+// X(left, right, polarity): one allpass per side; polarity (+1/-1) sets the
+// direction of the LFO excursion for this stage
+#define PLATEVERB_ALLPASSES(X) \
+  X(239, 263, +1)              \
+  X(421, 463, -1)
+
+// ----- Derived -----
+#define PLATEVERB_COMB_COUNT_(l, r)     + 1
+#define PLATEVERB_COMB_L_(l, r)         l,
+#define PLATEVERB_COMB_R_(l, r)         r,
+#define PLATEVERB_AP_COUNT_(l, r, pol)  + 1
+#define PLATEVERB_AP_L_(l, r, pol)      l,
+#define PLATEVERB_AP_R_(l, r, pol)      r,
+#define PLATEVERB_AP_POL_(l, r, pol)    (float)(pol),
+
+#define NUM_COMBS      (0 PLATEVERB_COMBS(PLATEVERB_COMB_COUNT_))
+#define NUM_ALLPASSES  (0 PLATEVERB_ALLPASSES(PLATEVERB_AP_COUNT_))
+
+#endif // PLATEVERB_TOPOLOGY_H
@@ -0,0 +1,299 @@
+// tools/bench.c
+// Tank benchmark and regression renders for the PlateVerb DSP core.
+//
+//   bench [-s SEC] [-r RATE]   time each preset, host-sized blocks
+//   bench -i N [-s SEC]        time N instances per host period
+//   bench --churn N            free instances while others run, N rounds
+//   bench --digest             print the digest of the reference renders
+//   bench --check              compare it with REGRESSION_DIGEST
+//                              (and, built with PLATEVERB_SELFTEST, check
+//                              the block kernels: plateverb_selftest())
+//
+// The reference renders run a fixed noise burst through every preset at
+// 48 and 44.1 kHz. Their digest is only stable in the deterministic build
+// (DETERMINISTIC=1, see `make check-regress`); any other build prints its
+// own digest but cannot check it. When a change to the DSP or to
+// src/topology.h is meant to change the sound, update REGRESSION_DIGEST
+// with the value `bench --digest` prints in the deterministic build.
+//
+// With -i the host thread's time per period is measured for both ways of
+// running many instances: plateverb_process() on each in turn, and
+// plateverb_process_batch(). In the parallel build (`make bench-parallel`)
+// these are the declared-latency engine and the zero-latency join.
+//
+// --churn creates and frees instances while another one keeps the worker
+// pool busy, so a worker can still hold a freed instance's job. It checks
+// nothing itself: `make check-parallel` runs it in the parallel build under
+// AddressSanitizer, which fails on any access to a freed instance.
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "plateverb.h"
+
+#define REGRESSION_DIGEST  0xa69767e629c5ea6eull
+#define BLOCK_FRAMES       128   // host period
+#define MAX_SETTINGS       8
+
+typedef struct {
+  const char* name;
+  struct { const char* symbol; float value; } set[MAX_SETTINGS];
+} Preset;
+
+// Cover the ends of the Size range, the gate, early reflections and modulation
+static const Preset presets[] = {
+  { "default",  { { NULL, 0.0f } } },
+  { "small",    { { "size", 0.3f }, { "decay_rt60", 0.8f }, { "mix", 1.0f } } },
+  { "large",    { { "size", 2.8f }, { "decay_rt60", 12.0f }, { "diffusion", 0.9f } } },
+  { "gated",    { { "gate", 0.6f }, { "decay_rt60", 6.0f }, { "mix", 1.0f } } },
+  { "early",    { { "early", 0.8f }, { "predelay_ms", 40.0f }, { "size", 1.4f } } },
+  { "mod",      { { "mod_depth", 4.5f }, { "mod_rate", 3.0f }, { "grit", 0.5f }, { "locut", 300.0f } } },
+};
+#define NUM_PRESETS ((int)(sizeof(presets) / sizeof(presets[0])))
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+// Deterministic noise: `burst` frames of it, then silence
+static void make_input(float* x, uint32_t n, uint32_t burst) {
+  uint32_t s = 1;
+  for (uint32_t i = 0; i < n; ++i) {
+    s = s * 1664525u + 1013904223u;
+    x[i] = (i < burst) ? ((float)(s >> 8) / 16777216.0f - 0.5f) * 0.8f : 0.0f;
+  }
+}
+
+static PlateVerb* preset_new(const Preset* p, double rate) {
+  PlateVerb* pv = plateverb_new(rate);
+  if (!pv) return NULL;
+  for (int i = 0; i < MAX_SETTINGS && p->set[i].symbol; ++i) {
+    plateverb_set(pv, plateverb_port_index(p->set[i].symbol), p->set[i].value);
+  }
+  return pv;
+}
+
+static void render(PlateVerb* pv, const float* in, float* l, float* r, uint32_t n) {
+  for (uint32_t off = 0; off < n; off += BLOCK_FRAMES) {
+    const uint32_t k = (n - off < BLOCK_FRAMES) ? n - off : BLOCK_FRAMES;
+    plateverb_process(pv, in + off, l + off, r + off, k);
+  }
+}
+
+// ----- Regression Digest -----
+static uint64_t fnv1a(uint64_t h, const void* data, size_t size) {
+  const uint8_t* p = (const uint8_t*)data;
+  for (size_t i = 0; i < size; ++i) h = (h ^ p[i]) * 0x100000001b3ull;
+  return h;
+}
+
+static int digest(uint64_t* out) {
+  static const double rates[] = { 48000.0, 44100.0 };
+  uint64_t h = 0xcbf29ce484222325ull;
+  for (int ri = 0; ri < 2; ++ri) {
+    const uint32_t n = (uint32_t)(rates[ri] * 1.5);
+    float* buf = (float*)malloc(3 * (size_t)n * sizeof(float));
+    if (!buf) return -1;
+    make_input(buf, n, n / 6);
+    for (int p = 0; p < NUM_PRESETS; ++p) {
+      PlateVerb* pv = preset_new(&presets[p], rates[ri]);
+      if (!pv) { free(buf); return -1; }
+      render(pv, buf, buf + n, buf + 2 * (size_t)n, n);
+      h = fnv1a(h, buf + n, 2 * (size_t)n * sizeof(float));
+      plateverb_free(pv);
+    }
+    free(buf);
+  }
+  *out = h;
+  return 0;
+}
+
+// ----- Timing -----
+static int bench(double seconds, double rate) {
+  const uint32_t n = (uint32_t)(rate * seconds);
+  float* buf = (float*)malloc(3 * (size_t)n * sizeof(float));
+  if (!buf || n == 0) { free(buf); return 1; }
+  // Keep the tank busy throughout, so no chunk takes the idle path
+  make_input(buf, n, n);
+  printf("%-10s %10s %12s\n", "preset", "ns/sample", "x realtime");
+  for (int p = 0; p < NUM_PRESETS; ++p) {
+    PlateVerb* pv = preset_new(&presets[p], rate);
+    if (!pv) { free(buf); return 1; }
+    render(pv, buf, buf + n, buf + 2 * (size_t)n, (uint32_t)(rate * 0.1));   // warm up
+    const double t0 = now_seconds();
+    render(pv, buf, buf + n, buf + 2 * (size_t)n, n);
+    const double dt = now_seconds() - t0;
+    printf("%-10s %10.1f %12.1f\n", presets[p].name, 1e9 * dt / n, seconds / dt);
+    plateverb_free(pv);
+  }
+  free(buf);
+  return 0;
+}
+
+// ----- Instances -----
+static int cmp_double(const void* a, const void* b) {
+  const double x = *(const double*)a, y = *(const double*)b;
+  return (x > y) - (x < y);
+}
+
+static void report(const char* name, double* t, uint32_t periods, double rate) {
+  double sum = 0.0;
+  for (uint32_t p = 0; p < periods; ++p) sum += t[p];
+  qsort(t, periods, sizeof(double), cmp_double);
+  const double mean = sum / periods;
+  printf("%-10s %10.1f %10.1f %10.1f %8.1f\n", name, 1e6 * mean, 1e6 * t[periods * 99 / 100],
+         1e6 * t[periods - 1], 100.0 * mean * rate / BLOCK_FRAMES);
+}
+
+static int bench_instances(int count, double seconds, double rate) {
+  const uint32_t periods = (uint32_t)(rate * seconds) / BLOCK_FRAMES;
+  const uint32_t warm = (uint32_t)(rate * 0.1) / BLOCK_FRAMES;
+  const uint32_t n = (periods + warm) * BLOCK_FRAMES;
+  float* in = (float*)malloc((size_t)n * sizeof(float));
+  float* out = (float*)malloc(2 * (size_t)count * BLOCK_FRAMES * sizeof(float));
+  double* t = (double*)malloc((size_t)periods * sizeof(double));
+  PlateVerb** pvs = (PlateVerb**)calloc((size_t)count, sizeof(PlateVerb*));
+  const float** ins = (const float**)malloc((size_t)count * sizeof(float*));
+  float** ls = (float**)malloc((size_t)count * sizeof(float*));
+  float** rs = (float**)malloc((size_t)count * sizeof(float*));
+  int ret = 1;
+  if (!in || !out || !t || !pvs || !ins || !ls || !rs || periods == 0) goto done;
+  make_input(in, n, n);
+  for (int k = 0; k < count; ++k) {
+    ls[k] = out + 2 * (size_t)k * BLOCK_FRAMES;
+    rs[k] = ls[k] + BLOCK_FRAMES;
+  }
+#ifdef PLATEVERB_PARALLEL
+  printf("%d instances, parallel build (frame %d)\n", count, PLATEVERB_PARALLEL);
+#else
+  printf("%d instances, serial build\n", count);
+#endif
+  printf("%-10s %10s %10s %10s %8s\n", "variant", "mean us", "p99 us", "max us", "load %");
+  for (int v = 0; v < 2; ++v) {
+    for (int k = 0; k < count; ++k) {
+      if (!(pvs[k] = preset_new(&presets[k % NUM_PRESETS], rate))) goto done;
+    }
+    for (uint32_t p = 0; p < periods + warm; ++p) {
+      const float* x = in + (size_t)p * BLOCK_FRAMES;
+      const double t0 = now_seconds();
+      if (v == 0) {
+        for (int k = 0; k < count; ++k) plateverb_process(pvs[k], x, ls[k], rs[k], BLOCK_FRAMES);
+      } else {
+        for (int k = 0; k < count; ++k) ins[k] = x;
+        plateverb_process_batch(pvs, (uint32_t)count, ins, ls, rs, BLOCK_FRAMES);
+      }
+      if (p >= warm) t[p - warm] = now_seconds() - t0;
+    }
+    report(v == 0 ? "process" : "batch", t, periods, rate);
+    for (int k = 0; k < count; ++k) {
+      plateverb_free(pvs[k]);
+      pvs[k] = NULL;
+    }
+  }
+  ret = 0;
+done:
+  if (pvs) {
+    for (int k = 0; k < count; ++k) plateverb_free(pvs[k]);
+  }
+  free(rs);
+  free(ls);
+  free(ins);
+  free(pvs);
+  free(t);
+  free(out);
+  free(in);
+  return ret;
+}
+
+// ----- Instance Churn -----
+static int churn(int rounds) {
+  float in[BLOCK_FRAMES], l[BLOCK_FRAMES], r[BLOCK_FRAMES];
+  make_input(in, BLOCK_FRAMES, BLOCK_FRAMES);
+  PlateVerb* hold = preset_new(&presets[0], 48000.0);
+  if (!hold) return 1;
+  for (int k = 0; k < rounds; ++k) {
+    PlateVerb* pv = preset_new(&presets[k % NUM_PRESETS], 48000.0);
+    if (!pv) { plateverb_free(hold); return 1; }
+    // Both ways of queueing jobs; the round number varies which frames
+    // are left in flight, and whether they are stolen, when pv is freed
+    for (int p = 0; p < 3 + k % 5; ++p) {
+      plateverb_process(pv, in, l, r, BLOCK_FRAMES);
+      plateverb_process(hold, in, l, r, BLOCK_FRAMES);
+    }
+    PlateVerb* both[2] = { pv, hold };
+    const float* ins[2] = { in, in };
+    float* ls[2] = { l, l + BLOCK_FRAMES / 2 };
+    float* rs[2] = { r, r + BLOCK_FRAMES / 2 };
+    if (k & 1) plateverb_process_batch(both, 2, ins, ls, rs, BLOCK_FRAMES / 2);
+    plateverb_process(pv, in, l, r, BLOCK_FRAMES);
+    plateverb_free(pv);
+    for (int p = 0; p < 4; ++p) plateverb_process(hold, in, l, r, BLOCK_FRAMES);
+  }
+  plateverb_free(hold);
+  printf("bench: %d rounds of instance churn\n", rounds);
+  return 0;
+}
+
+static void usage(void) {
+  fprintf(stderr,
+    "usage: bench [-s SEC] [-r RATE] [-i N] | --churn N | --digest | --check\n"
+    "  -s SEC     seconds of audio per preset (default 10)\n"
+    "  -r RATE    sample rate (default 48000)\n"
+    "  -i N       time N instances per period, one by one and batched\n"
+    "  --churn N  free instances while others run, N rounds\n"
+    "  --digest   print the digest of the reference renders\n"
+    "  --check    compare it with the recorded one (deterministic build)\n");
+}
+
+int main(int argc, char** argv) {
+  double seconds = 10.0, rate = 48000.0;
+  int mode = 0;   // 0 time, 1 digest, 2 check
+  int instances = 0, rounds = 0;
+  for (int i = 1; i < argc; ++i) {
+    const char* a = argv[i];
+    if (!strcmp(a, "-s") && i + 1 < argc) seconds = atof(argv[++i]);
+    else if (!strcmp(a, "-r") && i + 1 < argc) rate = atof(argv[++i]);
+    else if (!strcmp(a, "-i") && i + 1 < argc) instances = atoi(argv[++i]);
+    else if (!strcmp(a, "--churn") && i + 1 < argc) rounds = atoi(argv[++i]);
+    else if (!strcmp(a, "--digest")) mode = 1;
+    else if (!strcmp(a, "--check")) mode = 2;
+    else { usage(); return 2; }
+  }
+  if (rounds > 0) return churn(rounds);
+  if (mode == 0) return (instances > 0) ? bench_instances(instances, seconds, rate) : bench(seconds, rate);
+
+#ifdef PLATEVERB_SELFTEST
+  if (mode == 2) {
+    float iir1_error;
+    if (plateverb_selftest(&iir1_error) != 0) {
+      fprintf(stderr, "bench: block IIR differs from the recurrence: %.3g of peak\n", iir1_error);
+      return 1;
+    }
+    printf("bench: block IIR matches the recurrence (%.3g of peak)\n", iir1_error);
+  }
+#endif
+  uint64_t h;
+  if (digest(&h) != 0) return 1;
+  if (mode == 1) {
+    printf("0x%016llx\n", (unsigned long long)h);
+    return 0;
+  }
+#ifndef PLATEVERB_DETERMINISTIC
+  fprintf(stderr, "bench: --check needs the deterministic build (DETERMINISTIC=1)\n");
+  return 2;
+#else
+  if (h != REGRESSION_DIGEST) {
+    fprintf(stderr, "bench: reference renders changed: digest 0x%016llx, expected 0x%016llx\n",
+            (unsigned long long)h, (unsigned long long)REGRESSION_DIGEST);
+    return 1;
+  }
+  printf("bench: reference renders match (0x%016llx)\n", (unsigned long long)h);
+  return 0;
+#endif
+}
@@ -0,0 +1,923 @@
+// tools/render.c
+// Offline renderer: runs WAV files through the PlateVerb DSP core.
+//
+//   render [options] -o OUTDIR in.wav...
+//
+// Each lane is a pipeline of five threads,
+//   reader -> decode -> DSP -> encode -> writer,
+// joined by single-producer/single-consumer queues. A lane owns a fixed
+// pool of chunks that the writer hands back to the reader, so nothing is
+// allocated per chunk and the number of chunks in flight is bounded.
+// With -j N, N lanes split the file list between them.
+//
+// --checkpoint SEC saves the reverb state every SEC seconds next to each
+// output (out.wav.pvck), with a hash of the input between checkpoints.
+// --resume then re-renders only what an edit changed: it restarts from
+// the checkpoint before the first changed segment and, once past the
+// edit, stops as soon as the tank state is back within --converge of the
+// earlier render's, keeping the rest of the old output.
+//
+// By default the tail after each file is as long as the reverb needs:
+// rendering stops once the DSP core's tail estimate says the output has
+// fallen below -100 dBFS (at most AUTO_TAIL_MAX seconds).
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "plateverb.h"
+
+#define CHUNK_FRAMES     4096
+#define MAX_CHANNELS     8
+#define CHUNKS_PER_LANE  8
+#define QUEUE_LEN        16    // power of two, above CHUNKS_PER_LANE
+#define MAX_LANES        64
+#define CK_MAGIC         0x4b435650u   // "PVCK"
+#define CK_VERSION       3
+#define AUTO_TAIL_MAX    60.0  // seconds, --tail auto
+#define READAHEAD_CHUNKS 16    // input the reader asks the kernel for ahead of it
+
+enum { WAV_PCM = 1, WAV_FLOAT = 3, WAV_EXTENSIBLE = 0xFFFE };
+
+// ----- Utilities -----
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+static inline float clampf(float x, float lo, float hi) {
+  return (x < lo) ? lo : (x > hi) ? hi : x;
+}
+
+static inline uint16_t rd16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+static inline uint32_t rd32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+static inline void wr16(uint8_t* p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+static inline void wr32(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24);
+}
+
+// ----- Jobs and Chunks -----
+typedef struct {
+  int format;               // WAV_PCM or WAV_FLOAT
+  int bits;
+  int channels;
+  uint32_t rate;
+} WavFormat;
+
+typedef struct {
+  const char* in_path;
+  char out_path[4096];
+  WavFormat in;             // filled in by the reader
+  WavFormat out;
+  uint64_t data_offset;
+  uint64_t src_frames;      // frames in the input file
+  uint64_t tail_frames;     // silence rendered after them (the most, with --tail auto)
+  int failed;
+
+  // Checkpoints (see Checkpoints)
+  char ck_path[4104];
+  uint32_t ck_interval;     // frames per segment, a whole number of chunks
+  uint32_t n_segs;
+  uint64_t* seg_hash;       // input hash of each segment
+  int resume;               // re-rendering an earlier output in place
+  int up_to_date;           // input unchanged: nothing to render
+  uint64_t start_frame;     // first frame rendered (resume_seg's checkpoint)
+  uint32_t resume_seg;
+  uint32_t match_seg;       // input unchanged from this segment on
+  uint64_t old_out_frames;  // length of the earlier render
+  int spliced;              // converged: the rest of the old output stays
+
+  // Set by the DSP stage when it ends the file before tail_frames: the
+  // tail has died away, or a resume spliced in the earlier render
+  atomic_int stopped;
+  uint64_t end_frame;
+} FileJob;
+
+typedef struct {
+  FileJob* job;             // NULL: end of stream
+  int first;                // first/last chunk of its file
+  int last;
+  uint64_t pos;             // frame of the file where the chunk starts
+  uint32_t frames;
+  uint32_t src_frames;      // frames taken from the file; the rest is tail
+  uint32_t bytes;           // valid bytes in raw
+  uint8_t raw[CHUNK_FRAMES * MAX_CHANNELS * 4];   // file bytes, then encoded bytes
+  float mono[CHUNK_FRAMES];
+  float left[CHUNK_FRAMES];
+  float right[CHUNK_FRAMES];
+} Chunk;
+
+// ----- SPSC Queue -----
+// Exactly one thread pushes and one pops. The ring never overflows since
+// a lane owns fewer chunks than it has slots; the semaphore only lets the
+// consumer sleep instead of spinning when its stage is starved. A pushed
+// chunk belongs to the next stage and may already be recycled, so a stage
+// must not touch it after queue_push().
+typedef struct {
+  Chunk* slots[QUEUE_LEN];
+  atomic_size_t head;
+  atomic_size_t tail;
+  sem_t items;
+} Queue;
+
+static void queue_init(Queue* q) {
+  atomic_init(&q->head, 0);
+  atomic_init(&q->tail, 0);
+  sem_init(&q->items, 0, 0);
+}
+
+static void queue_push(Queue* q, Chunk* c) {
+  const size_t t = atomic_load_explicit(&q->tail, memory_order_relaxed);
+  q->slots[t & (QUEUE_LEN - 1)] = c;
+  atomic_store_explicit(&q->tail, t + 1, memory_order_release);
+  sem_post(&q->items);
+}
+
+static Chunk* queue_pop(Queue* q) {
+  while (sem_wait(&q->items) != 0 && errno == EINTR) {}
+  const size_t h = atomic_load_explicit(&q->head, memory_order_relaxed);
+  Chunk* c = q->slots[h & (QUEUE_LEN - 1)];
+  atomic_store_explicit(&q->head, h + 1, memory_order_release);
+  return c;
+}
+
+// ----- Lanes -----
+enum { STAGE_READ, STAGE_DECODE, STAGE_DSP, STAGE_ENCODE, STAGE_WRITE, NUM_STAGES };
+static const char* stage_names[NUM_STAGES] = { "read", "decode", "dsp", "encode", "write" };
+
+typedef struct {
+  double busy;              // seconds spent working, not waiting
+  uint64_t frames;
+  uint64_t bytes;           // file I/O (read/write only)
+} StageStats;
+
+typedef struct {
+  float value[PLATEVERB_NUM_PORTS];
+  int set[PLATEVERB_NUM_PORTS];
+  float effective[PLATEVERB_NUM_PORTS];   // with defaults filled in
+} Controls;
+
+typedef struct {
+  FileJob** jobs;           // this lane's share of the files
+  int n_jobs;
+  Queue q[NUM_STAGES];      // q[s] feeds stage s; q[STAGE_READ] is the free pool
+  Chunk* pool;
+  PlateVerb* pv;            // reused while the sample rate stays the same
+  double pv_rate;
+  const Controls* controls;
+  double tail_seconds;
+  int auto_tail;            // stop each file once its tail has died away
+  int float_out;
+  int verbose;
+  double ck_seconds;        // 0: no checkpoints
+  int resume;
+  float converge;           // largest state difference that counts as equal
+  int ck_fd;                // DSP stage: checkpoint file of the current job
+  uint8_t* ck_state[2];     // DSP stage: current and stored state
+  size_t ck_bytes;
+  StageStats stats[NUM_STAGES];
+} Lane;
+
+// ----- Reader -----
+static int read_full(int fd, uint8_t* buf, size_t n, uint64_t off) {
+  size_t got = 0;
+  while (got < n) {
+    const ssize_t r = pread(fd, buf + got, n - got, (off_t)(off + got));
+    if (r < 0 && errno == EINTR) continue;
+    if (r <= 0) return -1;
+    got += (size_t)r;
+  }
+  return 0;
+}
+
+// Ask the kernel to start reading input frames [from, from + n) now, so the
+// pread() that needs them finds them in the page cache. Advice only: a
+// failure changes nothing.
+static void read_ahead(int fd, const FileJob* job, uint64_t from, uint64_t n) {
+  if (from >= job->src_frames) return;
+  if (n > job->src_frames - from) n = job->src_frames - from;
+  const uint64_t frame_bytes = (uint64_t)(job->in.channels * job->in.bits / 8);
+  posix_fadvise(fd, (off_t)(job->data_offset + from * frame_bytes), (off_t)(n * frame_bytes), POSIX_FADV_WILLNEED);
+}
+
+// Find "fmt " and "data" in a RIFF/WAVE file
+static int wav_parse(int fd, FileJob* job) {
+  uint8_t h[12];
+  if (read_full(fd, h, 12, 0) || memcmp(h, "RIFF", 4) || memcmp(h + 8, "WAVE", 4)) return -1;
+  int have_fmt = 0;
+  uint32_t block_align = 0;
+  uint64_t off = 12;
+  for (;;) {
+    uint8_t ch[8];
+    if (read_full(fd, ch, 8, off)) return -1;
+    const uint32_t size = rd32(ch + 4);
+    if (!memcmp(ch, "fmt ", 4)) {
+      uint8_t f[40] = {0};
+      if (size < 16 || read_full(fd, f, size < 40 ? size : 40, off + 8)) return -1;
+      int format = rd16(f);
+      if (format == WAV_EXTENSIBLE && size >= 26) format = rd16(f + 24);
+      job->in.format = format;
+      job->in.channels = rd16(f + 2);
+      job->in.rate = rd32(f + 4);
+      block_align = rd16(f + 12);
+      job->in.bits = rd16(f + 14);
+      have_fmt = 1;
+    } else if (!memcmp(ch, "data", 4)) {
+      if (!have_fmt) return -1;
+      const int ok = (job->in.format == WAV_PCM && (job->in.bits == 16 || job->in.bits == 24 || job->in.bits == 32))
+                  || (job->in.format == WAV_FLOAT && job->in.bits == 32);
+      if (!ok || job->in.channels < 1 || job->in.channels > MAX_CHANNELS || job->in.rate == 0
+          || block_align != (uint32_t)(job->in.channels * job->in.bits / 8)) return -1;
+      job->data_offset = off + 8;
+      job->src_frames = size / block_align;
+      return 0;
+    }
+    off += 8 + (uint64_t)size + (size & 1);
+  }
+}
+
+// ----- Checkpoints -----
+// out.wav.pvck holds a CkHeader, the input hash of every segment, then the
+// reverb state at the start of every segment. The header goes in last, so
+// the file of an interrupted run is never trusted. The reader hashes the
+// input and plans a resume; the DSP stage saves, restores and compares
+// states.
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t rate;
+  uint32_t out_format;
+  uint32_t out_bits;
+  uint32_t interval;
+  uint64_t src_frames;
+  uint64_t tail_frames;
+  uint64_t out_frames;      // frames in the output file
+  uint32_t n_segs;
+  uint32_t state_bytes;
+  uint32_t auto_tail;
+  float controls[PLATEVERB_NUM_PORTS];
+} CkHeader;
+
+static void ck_header(const Lane* lane, const FileJob* job, uint32_t state_bytes, CkHeader* h) {
+  memset(h, 0, sizeof(*h));
+  h->magic = CK_MAGIC;
+  h->version = CK_VERSION;
+  h->rate = job->in.rate;
+  h->out_format = (uint32_t)job->out.format;
+  h->out_bits = (uint32_t)job->out.bits;
+  h->interval = job->ck_interval;
+  h->src_frames = job->src_frames;
+  h->tail_frames = job->tail_frames;
+  h->out_frames = job->src_frames + job->tail_frames;
+  h->n_segs = job->n_segs;
+  h->state_bytes = state_bytes;
+  h->auto_tail = (uint32_t)lane->auto_tail;
+  memcpy(h->controls, lane->controls->effective, sizeof(h->controls));
+}
+
+static uint64_t ck_state_offset(const FileJob* job, uint32_t seg, size_t state_bytes) {
+  return sizeof(CkHeader) + (uint64_t)job->n_segs * sizeof(uint64_t) + (uint64_t)seg * state_bytes;
+}
+
+// States stored for an output of out_frames: one per segment it reaches
+static uint32_t ck_states(const FileJob* job, uint64_t out_frames) {
+  return (uint32_t)((out_frames + job->ck_interval - 1) / job->ck_interval);
+}
+
+static int pwrite_full(int fd, const uint8_t* buf, size_t n, uint64_t off) {
+  size_t done = 0;
+  while (done < n) {
+    const ssize_t w = pwrite(fd, buf + done, n - done, (off_t)(off + done));
+    if (w < 0 && errno == EINTR) continue;
+    if (w <= 0) return -1;
+    done += (size_t)w;
+  }
+  return 0;
+}
+
+// Segment layout and FNV-1a hash of each segment's input bytes
+static int ck_hash_input(const Lane* lane, FileJob* job, int fd, uint8_t* buf) {
+  const uint64_t total = job->src_frames + job->tail_frames;
+  long chunks = lrint(lane->ck_seconds * job->in.rate / CHUNK_FRAMES);
+  if (chunks < 1) chunks = 1;
+  if (chunks > (long)(UINT32_MAX / CHUNK_FRAMES)) chunks = (long)(UINT32_MAX / CHUNK_FRAMES);
+  job->ck_interval = (uint32_t)chunks * CHUNK_FRAMES;
+  job->n_segs = (uint32_t)((total + job->ck_interval - 1) / job->ck_interval);
+  job->seg_hash = (uint64_t*)calloc(job->n_segs ? job->n_segs : 1, sizeof(uint64_t));
+  if (!job->seg_hash) return -1;
+
+  const uint32_t frame_bytes = (uint32_t)(job->in.channels * job->in.bits / 8);
+  for (uint32_t k = 0; k < job->n_segs; ++k) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    uint64_t pos = (uint64_t)k * job->ck_interval;
+    const uint64_t end = (pos + job->ck_interval < job->src_frames) ? pos + job->ck_interval : job->src_frames;
+    read_ahead(fd, job, end, job->ck_interval);   // the next segment, while this one is hashed
+    while (pos < end) {
+      const uint32_t n = (uint32_t)(end - pos < CHUNK_FRAMES ? end - pos : CHUNK_FRAMES);
+      if (read_full(fd, buf, (size_t)n * frame_bytes, job->data_offset + pos * frame_bytes)) return -1;
+      for (size_t i = 0; i < (size_t)n * frame_bytes; ++i) h = (h ^ buf[i]) * 0x100000001b3ull;
+      pos += n;
+    }
+    job->seg_hash[k] = h;
+  }
+  return 0;
+}
+
+// --resume: compare with the earlier render's hashes. Returns -1 (render
+// from scratch) unless the old output and checkpoints match these settings.
+static int ck_plan_resume(const Lane* lane, FileJob* job) {
+  CkHeader want, have;
+  ck_header(lane, job, 0, &want);
+  const int fd = open(job->ck_path, O_RDONLY);
+  if (fd < 0) return -1;
+  uint64_t* old = (uint64_t*)calloc(job->n_segs ? job->n_segs : 1, sizeof(uint64_t));
+  struct stat st;
+  int ok = old && !read_full(fd, (uint8_t*)&have, sizeof(have), 0);
+  if (ok) {
+    want.state_bytes = have.state_bytes;   // checked when the state is restored
+    want.out_frames = have.out_frames;     // up to the tail estimate
+    ok = !memcmp(&want, &have, sizeof(want))
+         && have.out_frames >= job->src_frames && have.out_frames <= job->src_frames + job->tail_frames
+         && !read_full(fd, (uint8_t*)old, job->n_segs * sizeof(uint64_t), sizeof(have))
+         && !fstat(fd, &st)
+         && (uint64_t)st.st_size == ck_state_offset(job, ck_states(job, have.out_frames), have.state_bytes);
+  }
+  close(fd);
+  ok = ok && !stat(job->out_path, &st)
+          && (uint64_t)st.st_size == 44 + have.out_frames * (uint64_t)(job->out.channels * job->out.bits / 8);
+  if (ok) {
+    uint32_t first = 0, match = job->n_segs;
+    while (first < job->n_segs && old[first] == job->seg_hash[first]) ++first;
+    while (match > first && old[match - 1] == job->seg_hash[match - 1]) --match;
+    job->resume = 1;
+    job->up_to_date = (first == job->n_segs);
+    job->resume_seg = first;
+    job->match_seg = match;
+    job->start_frame = (uint64_t)first * job->ck_interval;
+    job->old_out_frames = have.out_frames;
+  }
+  free(old);
+  return ok ? 0 : -1;
+}
+
+// DSP stage, first chunk of a job: open the checkpoint file and, when
+// resuming, load the state the render restarts from.
+static int ck_begin(Lane* lane, FileJob* job) {
+  const size_t bytes = plateverb_state_size(lane->pv);
+  if (bytes != lane->ck_bytes) {
+    for (int i = 0; i < 2; ++i) {
+      free(lane->ck_state[i]);
+      lane->ck_state[i] = (uint8_t*)malloc(bytes);
+    }
+    lane->ck_bytes = (lane->ck_state[0] && lane->ck_state[1]) ? bytes : 0;
+    if (!lane->ck_bytes) return -1;
+  }
+  lane->ck_fd = open(job->ck_path, job->resume ? O_RDWR : O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (lane->ck_fd < 0) return -1;
+  if (!job->resume) return 0;
+
+  const uint32_t invalid = 0;
+  if (pwrite_full(lane->ck_fd, (const uint8_t*)&invalid, sizeof(invalid), 0)
+      || read_full(lane->ck_fd, lane->ck_state[0], bytes, ck_state_offset(job, job->resume_seg, bytes))
+      || plateverb_state_restore(lane->pv, lane->ck_state[0], bytes)) {
+    fprintf(stderr, "render: %s: checkpoint does not fit this build, render without --resume\n", job->ck_path);
+    close(lane->ck_fd);
+    lane->ck_fd = -1;
+    return -1;
+  }
+  return 0;
+}
+
+// DSP stage, before each chunk is processed: store the state at segment
+// starts. Past the edit, compare it with the earlier render's instead and
+// splice once they agree: this chunk and the rest of the file are dropped.
+// The earlier render only has states up to where its output ended.
+static int ck_step(Lane* lane, Chunk* c) {
+  FileJob* job = c->job;
+  if (lane->ck_fd < 0 || c->pos % job->ck_interval) return 0;
+  const uint32_t seg = (uint32_t)(c->pos / job->ck_interval);
+  if (job->resume && seg == job->resume_seg) return 0;   // just restored
+
+  const size_t bytes = lane->ck_bytes;
+  const uint64_t off = ck_state_offset(job, seg, bytes);
+  plateverb_state_save(lane->pv, lane->ck_state[0], bytes);
+  if (job->resume && seg >= job->match_seg && c->pos < job->old_out_frames) {
+    if (read_full(lane->ck_fd, lane->ck_state[1], bytes, off)) return -1;
+    if (plateverb_state_distance(lane->ck_state[0], lane->ck_state[1], bytes) <= lane->converge) {
+      job->spliced = 1;
+      job->end_frame = c->pos;
+      atomic_store_explicit(&job->stopped, 1, memory_order_relaxed);
+      c->frames = 0;
+      return 0;
+    }
+  }
+  return pwrite_full(lane->ck_fd, lane->ck_state[0], bytes, off);
+}
+
+// DSP stage, last chunk of a job: hashes, then the header that validates them.
+// The file grows as states are written and ends after the last state the
+// output reaches; a re-render that came out shorter drops the older ones.
+static void ck_finish(Lane* lane, FileJob* job) {
+  if (lane->ck_fd < 0) return;
+  CkHeader h;
+  ck_header(lane, job, (uint32_t)lane->ck_bytes, &h);
+  if (job->spliced) h.out_frames = job->old_out_frames;
+  else if (atomic_load_explicit(&job->stopped, memory_order_relaxed)) h.out_frames = job->end_frame;
+  if (!job->failed
+      && (ftruncate(lane->ck_fd, (off_t)ck_state_offset(job, ck_states(job, h.out_frames), lane->ck_bytes))
+          || pwrite_full(lane->ck_fd, (const uint8_t*)job->seg_hash, job->n_segs * sizeof(uint64_t), sizeof(h))
+          || pwrite_full(lane->ck_fd, (const uint8_t*)&h, sizeof(h), 0))) {
+    fprintf(stderr, "render: %s: %s\n", job->ck_path, strerror(errno));
+    job->failed = 1;
+  }
+  close(lane->ck_fd);
+  lane->ck_fd = -1;
+}
+
+static void* reader_main(void* arg) {
+  Lane* lane = (Lane*)arg;
+  StageStats* st = &lane->stats[STAGE_READ];
+  uint8_t* scratch = (lane->ck_seconds > 0.0) ? (uint8_t*)malloc(CHUNK_FRAMES * MAX_CHANNELS * 4) : NULL;
+  for (int j = 0; j < lane->n_jobs; ++j) {
+    FileJob* job = lane->jobs[j];
+    const int fd = open(job->in_path, O_RDONLY);
+    if (fd < 0 || wav_parse(fd, job)) {
+      fprintf(stderr, "render: %s: not a supported WAV file\n", job->in_path);
+      job->failed = 1;
+      if (fd >= 0) close(fd);
+      continue;
+    }
+    // Read front to back (Linux doubles its readahead window for it)
+    posix_fadvise(fd, (off_t)job->data_offset, 0, POSIX_FADV_SEQUENTIAL);
+    job->out = job->in;
+    job->out.channels = 2;
+    if (lane->float_out) { job->out.format = WAV_FLOAT; job->out.bits = 32; }
+    job->tail_frames = (uint64_t)((lane->auto_tail ? AUTO_TAIL_MAX : lane->tail_seconds) * job->in.rate);
+    if (lane->ck_seconds > 0.0) {
+      const double t0 = now_seconds();
+      if (!scratch || ck_hash_input(lane, job, fd, scratch)) {
+        fprintf(stderr, "render: %s: cannot read input\n", job->in_path);
+        job->failed = 1;
+        close(fd);
+        continue;
+      }
+      if (lane->resume) ck_plan_resume(lane, job);
+      st->busy += now_seconds() - t0;
+      if (job->up_to_date) {
+        if (lane->verbose) fprintf(stderr, "%s: up to date\n", job->out_path);
+        close(fd);
+        continue;
+      }
+    }
+
+    const uint32_t frame_bytes = (uint32_t)(job->in.channels * job->in.bits / 8);
+    const uint64_t total = job->src_frames + job->tail_frames;
+    uint64_t pos = job->start_frame;
+    uint64_t advised = pos;   // frames before this have been read ahead
+    do {
+      // Keep READAHEAD_CHUNKS in flight ahead of the reader, half at a time
+      if (advised < pos + READAHEAD_CHUNKS * CHUNK_FRAMES) {
+        read_ahead(fd, job, advised, READAHEAD_CHUNKS / 2 * CHUNK_FRAMES);
+        advised += READAHEAD_CHUNKS / 2 * CHUNK_FRAMES;
+      }
+      Chunk* c = queue_pop(&lane->q[STAGE_READ]);
+      const double t0 = now_seconds();
+      c->job = job;
+      c->first = (pos == job->start_frame);
+      c->pos = pos;
+      if (atomic_load_explicit(&job->stopped, memory_order_relaxed)) {
+        // The DSP ended the file: one empty chunk closes it downstream
+        c->frames = c->src_frames = c->bytes = 0;
+        c->last = 1;
+        queue_push(&lane->q[STAGE_DECODE], c);
+        break;
+      }
+      const uint64_t left = total - pos;
+      c->frames = (uint32_t)(left < CHUNK_FRAMES ? left : CHUNK_FRAMES);
+      c->src_frames = 0;
+      if (pos < job->src_frames) {
+        const uint64_t src_left = job->src_frames - pos;
+        c->src_frames = (uint32_t)(src_left < c->frames ? src_left : c->frames);
+      }
+      c->bytes = c->src_frames * frame_bytes;
+      if (c->bytes && read_full(fd, c->raw, c->bytes, job->data_offset + pos * frame_bytes)) {
+        // Truncated file: render what is there as silence
+        memset(c->raw, 0, c->bytes);
+        job->failed = 1;
+      }
+      pos += c->frames;
+      c->last = (pos == total);
+      st->busy += now_seconds() - t0;
+      st->frames += c->frames;
+      st->bytes += c->bytes;
+      queue_push(&lane->q[STAGE_DECODE], c);
+    } while (pos < total);
+    close(fd);
+  }
+  free(scratch);
+  Chunk* end = queue_pop(&lane->q[STAGE_READ]);
+  end->job = NULL;
+  queue_push(&lane->q[STAGE_DECODE], end);
+  return NULL;
+}
+
+// ----- Decode -----
+// Input channels are summed to the mono input of the reverb.
+static void decode_chunk(Chunk* c) {
+  const WavFormat* f = &c->job->in;
+  const int ch = f->channels;
+  const float gain = 1.0f / (float)ch;
+  const uint8_t* p = c->raw;
+  for (uint32_t i = 0; i < c->src_frames; ++i) {
+    float sum = 0.0f;
+    for (int k = 0; k < ch; ++k) {
+      switch (f->bits) {
+        case 16: sum += (float)(int16_t)rd16(p) * (1.0f / 32768.0f); p += 2; break;
+        case 24: {
+          const int32_t v = (int32_t)((uint32_t)p[0] << 8 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 24) >> 8;
+          sum += (float)v * (1.0f / 8388608.0f);
+          p += 3;
+          break;
+        }
+        default: {
+          const uint32_t u = rd32(p);
+          if (f->format == WAV_FLOAT) { float x; memcpy(&x, &u, 4); sum += x; }
+          else sum += (float)((double)(int32_t)u * (1.0 / 2147483648.0));
+          p += 4;
+        }
+      }
+    }
+    c->mono[i] = sum * gain;
+  }
+  memset(c->mono + c->src_frames, 0, (c->frames - c->src_frames) * sizeof(float));
+}
+
+static void* decode_main(void* arg) {
+  Lane* lane = (Lane*)arg;
+  StageStats* st = &lane->stats[STAGE_DECODE];
+  for (;;) {
+    Chunk* c = queue_pop(&lane->q[STAGE_DECODE]);
+    if (c->job) {
+      const double t0 = now_seconds();
+      decode_chunk(c);
+      st->busy += now_seconds() - t0;
+      st->frames += c->frames;
+    }
+    const int end = !c->job;
+    queue_push(&lane->q[STAGE_DSP], c);
+    if (end) return NULL;
+  }
+}
+
+// ----- DSP -----
+static void* dsp_main(void* arg) {
+  Lane* lane = (Lane*)arg;
+  StageStats* st = &lane->stats[STAGE_DSP];
+  for (;;) {
+    Chunk* c = queue_pop(&lane->q[STAGE_DSP]);
+    if (c->job) {
+      const double t0 = now_seconds();
+      if (c->first) {
+        // Every file starts from a cleared tank
+        if (lane->pv && lane->pv_rate != (double)c->job->in.rate) {
+          plateverb_free(lane->pv);
+          lane->pv = NULL;
+        }
+        if (!lane->pv) {
+          lane->pv = plateverb_new((double)c->job->in.rate);
+          lane->pv_rate = (double)c->job->in.rate;
+        } else {
+          plateverb_reset(lane->pv);
+        }
+        for (int p = 0; lane->pv && p < PLATEVERB_NUM_PORTS; ++p) {
+          if (lane->controls->set[p]) plateverb_set(lane->pv, p, lane->controls->value[p]);
+        }
+        if (lane->pv && c->job->seg_hash && ck_begin(lane, c->job)) {
+          fprintf(stderr, "render: %s: cannot write checkpoints\n", c->job->ck_path);
+          c->job->failed = 1;
+        }
+      }
+      FileJob* job = c->job;
+      if (atomic_load_explicit(&job->stopped, memory_order_relaxed)) c->frames = 0;
+      else if (lane->pv && job->seg_hash && ck_step(lane, c)) job->failed = 1;
+      if (lane->pv) {
+        plateverb_process(lane->pv, c->mono, c->left, c->right, c->frames);
+        // Past the input, end the file once the tail has died away
+        if (lane->auto_tail && c->frames && !c->last && c->pos + c->frames >= job->src_frames
+            && plateverb_tail_seconds(lane->pv) <= 0.0f) {
+          job->end_frame = c->pos + c->frames;
+          atomic_store_explicit(&job->stopped, 1, memory_order_relaxed);
+        }
+      } else {
+        memset(c->left, 0, c->frames * sizeof(float));
+        memset(c->right, 0, c->frames * sizeof(float));
+        c->job->failed = 1;
+      }
+      if (c->last && c->job->seg_hash) ck_finish(lane, c->job);
+      st->busy += now_seconds() - t0;
+      st->frames += c->frames;
+    }
+    const int end = !c->job;
+    queue_push(&lane->q[STAGE_ENCODE], c);
+    if (end) return NULL;
+  }
+}
+
+// ----- Encode -----
+static void encode_chunk(Chunk* c) {
+  const WavFormat* f = &c->job->out;
+  uint8_t* p = c->raw;
+  for (uint32_t i = 0; i < c->frames; ++i) {
+    const float s[2] = { c->left[i], c->right[i] };
+    for (int k = 0; k < 2; ++k) {
+      if (f->format == WAV_FLOAT) {
+        uint32_t u;
+        memcpy(&u, &s[k], 4);
+        wr32(p, u); p += 4;
+        continue;
+      }
+      const float x = clampf(s[k], -1.0f, 1.0f);
+      switch (f->bits) {
+        case 16: wr16(p, (uint16_t)(int16_t)lrintf(x * 32767.0f)); p += 2; break;
+        case 24: {
+          const int32_t v = (int32_t)lrintf(x * 8388607.0f);
+          p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p += 3;
+          break;
+        }
+        default: wr32(p, (uint32_t)(int32_t)lrint((double)x * 2147483647.0)); p += 4;
+      }
+    }
+  }
+  c->bytes = (uint32_t)(p - c->raw);
+}
+
+static void* encode_main(void* arg) {
+  Lane* lane = (Lane*)arg;
+  StageStats* st = &lane->stats[STAGE_ENCODE];
+  for (;;) {
+    Chunk* c = queue_pop(&lane->q[STAGE_ENCODE]);
+    if (c->job) {
+      const double t0 = now_seconds();
+      encode_chunk(c);
+      st->busy += now_seconds() - t0;
+      st->frames += c->frames;
+    }
+    const int end = !c->job;
+    queue_push(&lane->q[STAGE_WRITE], c);
+    if (end) return NULL;
+  }
+}
+
+// ----- Writer -----
+static void wav_header(uint8_t h[44], const WavFormat* f, uint64_t data_bytes) {
+  const uint32_t block_align = (uint32_t)(f->channels * f->bits / 8);
+  memcpy(h, "RIFF", 4);
+  wr32(h + 4, (uint32_t)(36 + data_bytes));
+  memcpy(h + 8, "WAVEfmt ", 8);
+  wr32(h + 16, 16);
+  wr16(h + 20, (uint16_t)f->format);
+  wr16(h + 22, (uint16_t)f->channels);
+  wr32(h + 24, f->rate);
+  wr32(h + 28, f->rate * block_align);
+  wr16(h + 32, (uint16_t)block_align);
+  wr16(h + 34, (uint16_t)f->bits);
+  memcpy(h + 36, "data", 4);
+  wr32(h + 40, (uint32_t)data_bytes);
+}
+
+static int write_full(int fd, const uint8_t* buf, size_t n) {
+  while (n) {
+    const ssize_t w = write(fd, buf, n);
+    if (w < 0 && errno == EINTR) continue;
+    if (w <= 0) return -1;
+    buf += w;
+    n -= (size_t)w;
+  }
+  return 0;
+}
+
+static void* writer_main(void* arg) {
+  Lane* lane = (Lane*)arg;
+  StageStats* st = &lane->stats[STAGE_WRITE];
+  int fd = -1;
+  uint64_t data_bytes = 0;
+  for (;;) {
+    Chunk* c = queue_pop(&lane->q[STAGE_WRITE]);
+    if (!c->job) return NULL;
+    const double t0 = now_seconds();
+    FileJob* job = c->job;
+    if (c->first && job->resume) {
+      // Overwrite from the resume point
+      const uint64_t block_align = (uint64_t)(job->out.channels * job->out.bits / 8);
+      fd = open(job->out_path, O_WRONLY);
+      if (fd < 0 || lseek(fd, (off_t)(44 + c->pos * block_align), SEEK_SET) < 0) {
+        fprintf(stderr, "render: %s: %s\n", job->out_path, strerror(errno));
+        job->failed = 1;
+      }
+      data_bytes = c->pos * block_align;
+    } else if (c->first) {
+      uint8_t h[44];
+      wav_header(h, &job->out, 0);
+      fd = open(job->out_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (fd < 0 || write_full(fd, h, sizeof(h))) {
+        fprintf(stderr, "render: %s: %s\n", job->out_path, strerror(errno));
+        job->failed = 1;
+      }
+      data_bytes = 0;
+    }
+    if (fd >= 0 && write_full(fd, c->raw, c->bytes)) job->failed = 1;
+    data_bytes += c->bytes;
+    if (c->last && fd >= 0) {
+      // A splice keeps the earlier render's length; otherwise the output
+      // ends here, which a resumed file may have to be cut back to
+      if (!job->spliced) {
+        uint8_t h[44];
+        wav_header(h, &job->out, data_bytes);
+        if (pwrite(fd, h, sizeof(h), 0) != (ssize_t)sizeof(h)) job->failed = 1;
+        if (job->resume && ftruncate(fd, (off_t)(44 + data_bytes))) job->failed = 1;
+      }
+      close(fd);
+      fd = -1;
+      if (lane->verbose) {
+        const double rate = (double)job->in.rate;
+        fprintf(stderr, "%s -> %s (", job->in_path, job->out_path);
+        if (job->resume) fprintf(stderr, "from %.1f s, ", (double)job->start_frame / rate);
+        if (job->spliced) fprintf(stderr, "earlier render kept from %.1f s)\n", (double)job->end_frame / rate);
+        else {
+          const uint64_t frames = data_bytes / (uint64_t)(job->out.channels * job->out.bits / 8);
+          fprintf(stderr, "%.1f s tail)\n", (double)(frames - job->src_frames) / rate);
+        }
+      }
+    }
+    st->busy += now_seconds() - t0;
+    st->frames += c->frames;
+    st->bytes += c->bytes;
+    queue_push(&lane->q[STAGE_READ], c);
+  }
+}
+
+// ----- Main -----
+static void usage(void) {
+  fprintf(stderr,
+    "usage: render [options] -o OUTDIR in.wav...\n"
+    "  -o DIR         output directory (required)\n"
+    "  -j N           pipelines to run in parallel (default 1)\n"
+    "  --tail SEC     seconds of tail rendered after each file, or 'auto' to\n"
+    "                 stop once it falls below -100 dBFS (default auto)\n"
+    "  --set SYM=VAL  set a control, e.g. --set decay_rt60=4 (repeatable)\n"
+    "  --float        write 32-bit float output\n"
+    "  --checkpoint SEC  save the reverb state every SEC seconds (OUT.wav.pvck)\n"
+    "  --resume       re-render only what changed since the last checkpointed\n"
+    "                 render of the same output (implies --checkpoint 10)\n"
+    "  --converge DB  state difference at which a resume splices in the\n"
+    "                 earlier render (default -120)\n"
+    "  -v             list files as they finish\n");
+}
+
+int main(int argc, char** argv) {
+  const char* out_dir = NULL;
+  int lanes = 1;
+  double tail = AUTO_TAIL_MAX;
+  int auto_tail = 1, float_out = 0, verbose = 0, resume = 0;
+  double ck_seconds = 0.0, converge_db = -120.0;
+  Controls controls;
+  memset(&controls, 0, sizeof(controls));
+  const char** inputs = (const char**)calloc((size_t)argc, sizeof(char*));
+  int n_inputs = 0;
+
+  for (int i = 1; i < argc; ++i) {
+    const char* a = argv[i];
+    if (!strcmp(a, "-o") && i + 1 < argc) out_dir = argv[++i];
+    else if (!strcmp(a, "-j") && i + 1 < argc) lanes = atoi(argv[++i]);
+    else if (!strcmp(a, "--tail") && i + 1 < argc) {
+      const char* v = argv[++i];
+      auto_tail = !strcmp(v, "auto");
+      if (!auto_tail) tail = atof(v);
+    }
+    else if (!strcmp(a, "--float")) float_out = 1;
+    else if (!strcmp(a, "--checkpoint") && i + 1 < argc) ck_seconds = atof(argv[++i]);
+    else if (!strcmp(a, "--resume")) resume = 1;
+    else if (!strcmp(a, "--converge") && i + 1 < argc) converge_db = atof(argv[++i]);
+    else if (!strcmp(a, "-v")) verbose = 1;
+    else if (!strcmp(a, "--set") && i + 1 < argc) {
+      char sym[64];
+      const char* v = argv[++i];
+      const char* eq = strchr(v, '=');
+      const size_t len = eq ? (size_t)(eq - v) : 0;
+      if (!eq || len >= sizeof(sym)) { usage(); return 2; }
+      memcpy(sym, v, len);
+      sym[len] = '\0';
+      const int port = plateverb_port_index(sym);
+      if (port < PLATEVERB_MIX || port >= PLATEVERB_LATENCY) { fprintf(stderr, "render: unknown control '%s'\n", sym); return 2; }
+      controls.value[port] = (float)atof(eq + 1);
+      controls.set[port] = 1;
+    }
+    else if (a[0] == '-') { usage(); return 2; }
+    else inputs[n_inputs++] = a;
+  }
+  if (!out_dir || n_inputs == 0) { usage(); return 2; }
+  if (lanes < 1) lanes = 1;
+  if (lanes > MAX_LANES) lanes = MAX_LANES;
+  if (lanes > n_inputs) lanes = n_inputs;
+  if (tail < 0.0) tail = 0.0;
+  if (resume && ck_seconds <= 0.0) ck_seconds = 10.0;
+
+  // Checkpoints record the settings they were taken with
+  PlateVerb* probe = plateverb_new(48000.0);
+  if (!probe) return 1;
+  for (int p = 0; p < PLATEVERB_NUM_PORTS; ++p) {
+    controls.effective[p] = controls.set[p] ? controls.value[p] : plateverb_get(probe, p);
+  }
+  plateverb_free(probe);
+
+  FileJob* jobs = (FileJob*)calloc((size_t)n_inputs, sizeof(FileJob));
+  Lane* lane = (Lane*)calloc((size_t)lanes, sizeof(Lane));
+  if (!jobs || !lane) return 1;
+  for (int i = 0; i < n_inputs; ++i) {
+    const char* base = strrchr(inputs[i], '/');
+    base = base ? base + 1 : inputs[i];
+    jobs[i].in_path = inputs[i];
+    snprintf(jobs[i].out_path, sizeof(jobs[i].out_path), "%s/%s", out_dir, base);
+    snprintf(jobs[i].ck_path, sizeof(jobs[i].ck_path), "%s.pvck", jobs[i].out_path);
+    if (!strcmp(jobs[i].out_path, inputs[i])) {
+      fprintf(stderr, "render: %s: output would overwrite the input\n", inputs[i]);
+      return 2;
+    }
+  }
+
+  pthread_t threads[MAX_LANES][NUM_STAGES];
+  void* (*const stage_main[NUM_STAGES])(void*) = { reader_main, decode_main, dsp_main, encode_main, writer_main };
+  const double t0 = now_seconds();
+  for (int l = 0; l < lanes; ++l) {
+    Lane* ln = &lane[l];
+    ln->jobs = (FileJob**)calloc((size_t)n_inputs, sizeof(FileJob*));
+    ln->pool = (Chunk*)calloc(CHUNKS_PER_LANE, sizeof(Chunk));
+    if (!ln->jobs || !ln->pool) return 1;
+    for (int i = l; i < n_inputs; i += lanes) ln->jobs[ln->n_jobs++] = &jobs[i];
+    ln->controls = &controls;
+    ln->tail_seconds = tail;
+    ln->auto_tail = auto_tail;
+    ln->float_out = float_out;
+    ln->verbose = verbose;
+    ln->ck_seconds = ck_seconds;
+    ln->resume = resume;
+    ln->converge = (float)pow(10.0, converge_db / 20.0);
+    ln->ck_fd = -1;
+    for (int s = 0; s < NUM_STAGES; ++s) queue_init(&ln->q[s]);
+    for (int k = 0; k < CHUNKS_PER_LANE; ++k) queue_push(&ln->q[STAGE_READ], &ln->pool[k]);
+    for (int s = 0; s < NUM_STAGES; ++s) pthread_create(&threads[l][s], NULL, stage_main[s], ln);
+  }
+
+  StageStats total[NUM_STAGES];
+  memset(total, 0, sizeof(total));
+  double audio_seconds = 0.0;
+  for (int l = 0; l < lanes; ++l) {
+    for (int s = 0; s < NUM_STAGES; ++s) {
+      pthread_join(threads[l][s], NULL);
+      total[s].busy += lane[l].stats[s].busy;
+      total[s].frames += lane[l].stats[s].frames;
+      total[s].bytes += lane[l].stats[s].bytes;
+    }
+    plateverb_free(lane[l].pv);
+    free(lane[l].ck_state[0]);
+    free(lane[l].ck_state[1]);
+  }
+  const double wall = now_seconds() - t0;
+
+  int failed = 0;
+  for (int i = 0; i < n_inputs; ++i) {
+    failed += jobs[i].failed;
+    if (!jobs[i].failed && !jobs[i].up_to_date && jobs[i].in.rate) {
+      // Count only the frames actually rendered
+      const uint64_t end = atomic_load(&jobs[i].stopped) ? jobs[i].end_frame : jobs[i].src_frames + jobs[i].tail_frames;
+      audio_seconds += (double)(end - jobs[i].start_frame) / jobs[i].in.rate;
+    }
+    free(jobs[i].seg_hash);
+  }
+
+  // Per-stage throughput: busy time excludes waiting on neighbours, so the
+  // stage with the lowest realtime factor is the bottleneck
+  fprintf(stderr, "%d file(s), %.1f s of audio in %.2f s (%.1fx realtime, %d lane(s))\n",
+          n_inputs - failed, audio_seconds, wall, wall > 0.0 ? audio_seconds / wall : 0.0, lanes);
+  for (int s = 0; s < NUM_STAGES; ++s) {
+    const double busy = total[s].busy > 1e-9 ? total[s].busy : 1e-9;
+    fprintf(stderr, "  %-7s busy %7.3f s  %8.1fx realtime", stage_names[s], total[s].busy, audio_seconds / busy);
+    if (total[s].bytes) fprintf(stderr, "  %8.1f MB/s", (double)total[s].bytes / busy / 1e6);
+    fprintf(stderr, "\n");
+  }
+  return failed ? 1 : 0;
+}
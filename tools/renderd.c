@@ -0,0 +1,308 @@
+// tools/renderd.c
+// Local render daemon: keeps warm PlateVerb instances and renders jobs
+// from clients on the same machine.
+//
+//   renderd [-s SOCKET] [--warm RATE:N]... [-v]
+//
+// Clients talk SOCK_SEQPACKET over a Unix socket (see renderd_client.h).
+// Each job carries a memfd holding its input and output buffers; the
+// daemon maps it once per connection and renders in place, so no audio
+// crosses the socket. Instances are reset and parked in a per-rate pool
+// after each job, so a job never pays for instantiate(), allocation or
+// first-touch page faults of the delay arena.
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "plateverb.h"
+#include "renderd_client.h"
+
+#define MAX_POOLS  8
+
+static int verbose;
+static char socket_path[sizeof(((struct sockaddr_un*)0)->sun_path)];
+
+// ----- Instance Pool -----
+// Idle instances, one stack per sample rate. Instances come back reset,
+// so a job only has to apply its controls.
+typedef struct Idle {
+  struct Idle* next;
+  PlateVerb* pv;
+} Idle;
+
+typedef struct {
+  double rate;
+  Idle* idle;
+} Pool;
+
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static Pool pools[MAX_POOLS];
+static int num_pools;
+static float defaults[PLATEVERB_NUM_PORTS];
+
+static Pool* pool_find(double rate) {
+  for (int i = 0; i < num_pools; ++i) {
+    if (pools[i].rate == rate) return &pools[i];
+  }
+  if (num_pools == MAX_POOLS) return NULL;
+  pools[num_pools].rate = rate;
+  pools[num_pools].idle = NULL;
+  return &pools[num_pools++];
+}
+
+static PlateVerb* pool_take(double rate) {
+  pthread_mutex_lock(&pool_lock);
+  Pool* pool = pool_find(rate);
+  Idle* it = pool ? pool->idle : NULL;
+  if (it) pool->idle = it->next;
+  pthread_mutex_unlock(&pool_lock);
+  if (!it) return plateverb_new(rate);
+  PlateVerb* pv = it->pv;
+  free(it);
+  return pv;
+}
+
+static void pool_give(double rate, PlateVerb* pv) {
+  plateverb_reset(pv);
+  for (int p = PLATEVERB_MIX; p < PLATEVERB_LATENCY; ++p) plateverb_set(pv, p, defaults[p]);
+  Idle* it = (Idle*)malloc(sizeof(*it));
+  pthread_mutex_lock(&pool_lock);
+  Pool* pool = pool_find(rate);
+  if (pool && it) {
+    it->pv = pv;
+    it->next = pool->idle;
+    pool->idle = it;
+    pv = NULL;
+  }
+  pthread_mutex_unlock(&pool_lock);
+  if (pv) {
+    // Too many distinct rates: this one does not stay warm
+    free(it);
+    plateverb_free(pv);
+  }
+}
+
+static int pool_warm(double rate, int count) {
+  for (int i = 0; i < count; ++i) {
+    PlateVerb* pv = plateverb_new(rate);
+    if (!pv) return -1;
+    // One silent block touches the arena, so its pages are resident too
+    static float scratch[3][256];
+    plateverb_process(pv, scratch[0], scratch[1], scratch[2], 256);
+    pool_give(rate, pv);
+  }
+  return 0;
+}
+
+// ----- Connections -----
+// The client reuses one memfd across jobs but sends a fresh descriptor
+// with each, so mappings are keyed by the file they point at. The file
+// must be sealed against shrinking: a client that truncated it under the
+// mapping would make the daemon's next access fault with SIGBUS.
+typedef struct {
+  dev_t dev;
+  ino_t ino;
+  size_t bytes;
+  float* base;
+} Mapping;
+
+static int map_job(Mapping* m, int fd) {
+  const int seals = fcntl(fd, F_GET_SEALS);
+  if (seals < 0 || !(seals & F_SEAL_SHRINK)) return EPERM;
+  struct stat st;
+  if (fstat(fd, &st) < 0) return errno;
+  if (m->base && m->dev == st.st_dev && m->ino == st.st_ino && m->bytes == (size_t)st.st_size) return 0;
+  if (m->base) munmap(m->base, m->bytes);
+  m->base = NULL;
+  if (st.st_size <= 0) return EINVAL;
+  void* p = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (p == MAP_FAILED) return errno;
+  m->dev = st.st_dev;
+  m->ino = st.st_ino;
+  m->bytes = (size_t)st.st_size;
+  m->base = (float*)p;
+  return 0;
+}
+
+static int check_request(const RenderdRequest* req, const Mapping* m) {
+  if (req->magic != RENDERD_MAGIC) return EPROTO;
+  if (req->n_in > req->buf_in || req->n_out > req->buf_out || req->n_in > req->n_out) return EINVAL;
+  if (((size_t)req->buf_in + 2 * (size_t)req->buf_out) * sizeof(float) > m->bytes) return EINVAL;
+  if (!(req->sample_rate >= 8000.0 && req->sample_rate <= 384000.0)) return EINVAL;
+  if (req->n_controls > RENDERD_MAX_CONTROLS) return EINVAL;
+  for (uint32_t i = 0; i < req->n_controls; ++i) {
+    if (req->port[i] < PLATEVERB_MIX || req->port[i] >= PLATEVERB_LATENCY) return EINVAL;
+  }
+  return 0;
+}
+
+static int render_job(const RenderdRequest* req, const Mapping* m, PlateVerb** pv) {
+  *pv = pool_take(req->sample_rate);
+  if (!*pv) return ENOMEM;
+  for (uint32_t i = 0; i < req->n_controls; ++i) plateverb_set(*pv, req->port[i], req->value[i]);
+
+  float* in = m->base;
+  float* out_l = in + req->buf_in;
+  float* out_r = out_l + req->buf_out;
+  plateverb_process(*pv, in, out_l, out_r, req->n_in);
+  if (req->n_out > req->n_in) {
+    // Tail: silent input, rendered in place from out_l (the input may
+    // alias an output)
+    const uint32_t n = req->n_out - req->n_in;
+    memset(out_l + req->n_in, 0, n * sizeof(float));
+    plateverb_process(*pv, out_l + req->n_in, out_l + req->n_in, out_r + req->n_in, n);
+  }
+  return 0;
+}
+
+static int recv_request(int sock, RenderdRequest* req, int* fd) {
+  union { char buf[CMSG_SPACE(sizeof(int))]; struct cmsghdr align; } ctl;
+  struct iovec iov = { req, sizeof(*req) };
+  memset(req, 0, sizeof(*req));
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = ctl.buf;
+  msg.msg_controllen = sizeof(ctl.buf);
+
+  ssize_t r;
+  do r = recvmsg(sock, &msg, MSG_CMSG_CLOEXEC); while (r < 0 && errno == EINTR);
+  *fd = -1;
+  for (struct cmsghdr* cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+    if (cm->cmsg_level == SOL_SOCKET && cm->cmsg_type == SCM_RIGHTS) memcpy(fd, CMSG_DATA(cm), sizeof(int));
+  }
+  if (r <= 0) return -1;    // hang-up or error
+  if (r != (ssize_t)sizeof(*req) || (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) || *fd < 0) return EPROTO;
+  return 0;
+}
+
+static void* connection(void* arg) {
+  const int sock = (int)(intptr_t)arg;
+  Mapping m;
+  memset(&m, 0, sizeof(m));
+  unsigned long jobs = 0;
+
+  for (;;) {
+    RenderdRequest req;
+    int fd;
+    int status = recv_request(sock, &req, &fd);
+    if (status < 0) {
+      if (fd >= 0) close(fd);
+      break;
+    }
+    if (status == 0) status = map_job(&m, fd);
+    if (fd >= 0) close(fd);
+    if (status == 0) status = check_request(&req, &m);
+
+    PlateVerb* pv = NULL;
+    if (status == 0) status = render_job(&req, &m, &pv);
+
+    // Reply first; resetting the instance is off the client's critical path
+    RenderdReply rep = { req.id, status };
+    const int sent = send(sock, &rep, sizeof(rep), MSG_NOSIGNAL) == (ssize_t)sizeof(rep);
+    if (pv) pool_give(req.sample_rate, pv);
+    if (!sent) break;
+    ++jobs;
+  }
+
+  if (m.base) munmap(m.base, m.bytes);
+  close(sock);
+  if (verbose) fprintf(stderr, "renderd: connection closed after %lu jobs\n", jobs);
+  return NULL;
+}
+
+// ----- Main -----
+static void on_signal(int sig) {
+  (void)sig;
+  unlink(socket_path);
+  _exit(0);
+}
+
+static void usage(void) {
+  fprintf(stderr,
+    "usage: renderd [options]\n"
+    "  -s SOCKET      listening socket (default " RENDERD_DEFAULT_SOCKET ")\n"
+    "  --warm RATE:N  keep N instances warm at RATE Hz (repeatable)\n"
+    "  -v             log connections\n");
+}
+
+int main(int argc, char** argv) {
+  // Defaults for pool_give(), taken from a fresh instance
+  PlateVerb* probe = plateverb_new(48000.0);
+  if (!probe) return 1;
+  for (int p = PLATEVERB_MIX; p < PLATEVERB_LATENCY; ++p) defaults[p] = plateverb_get(probe, p);
+  plateverb_free(probe);
+
+  const char* path = RENDERD_DEFAULT_SOCKET;
+  for (int i = 1; i < argc; ++i) {
+    const char* a = argv[i];
+    if (!strcmp(a, "-s") && i + 1 < argc) path = argv[++i];
+    else if (!strcmp(a, "-v")) verbose = 1;
+    else if (!strcmp(a, "--warm") && i + 1 < argc) {
+      double rate;
+      int count;
+      if (sscanf(argv[++i], "%lf:%d", &rate, &count) != 2 || rate < 8000.0 || rate > 384000.0 || count < 0) {
+        usage();
+        return 1;
+      }
+      if (pool_warm(rate, count) < 0) {
+        fprintf(stderr, "renderd: out of memory warming %g Hz instances\n", rate);
+        return 1;
+      }
+    }
+    else { usage(); return 1; }
+  }
+  if (strlen(path) >= sizeof(socket_path)) {
+    fprintf(stderr, "renderd: socket path too long\n");
+    return 1;
+  }
+  strcpy(socket_path, path);
+
+  const int srv = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, socket_path);
+  unlink(socket_path);
+  if (srv < 0 || bind(srv, (const struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(srv, 64) < 0) {
+    fprintf(stderr, "renderd: %s: %s\n", socket_path, strerror(errno));
+    return 1;
+  }
+  signal(SIGPIPE, SIG_IGN);
+  signal(SIGINT, on_signal);
+  signal(SIGTERM, on_signal);
+  if (verbose) fprintf(stderr, "renderd: listening on %s\n", socket_path);
+
+  pthread_attr_t attr;
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+  for (;;) {
+    const int sock = accept4(srv, NULL, NULL, SOCK_CLOEXEC);
+    if (sock < 0) {
+      if (errno == EINTR || errno == ECONNABORTED) continue;
+      fprintf(stderr, "renderd: accept: %s\n", strerror(errno));
+      if (errno == EMFILE || errno == ENFILE) { sleep(1); continue; }
+      break;
+    }
+    pthread_t th;
+    if (pthread_create(&th, &attr, connection, (void*)(intptr_t)sock) != 0) {
+      close(sock);
+      continue;
+    }
+    if (verbose) fprintf(stderr, "renderd: connection accepted\n");
+  }
+  unlink(socket_path);
+  return 1;
+}
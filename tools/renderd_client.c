@@ -0,0 +1,113 @@
+// tools/renderd_client.c
+#define _GNU_SOURCE
+
+#include "renderd_client.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+int renderd_connect(const char* socket_path) {
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (!socket_path) socket_path = RENDERD_DEFAULT_SOCKET;
+  if (strlen(socket_path) >= sizeof(addr.sun_path)) { errno = ENAMETOOLONG; return -1; }
+  strcpy(addr.sun_path, socket_path);
+
+  const int sock = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  if (sock < 0) return -1;
+  if (connect(sock, (const struct sockaddr*)&addr, sizeof(addr)) < 0) {
+    const int e = errno;
+    close(sock);
+    errno = e;
+    return -1;
+  }
+  return sock;
+}
+
+int renderd_buffer_init(RenderdBuffer* b, uint32_t n_in, uint32_t n_out) {
+  memset(b, 0, sizeof(*b));
+  b->fd = -1;
+  b->bytes = ((size_t)n_in + 2 * (size_t)n_out) * sizeof(float);
+  const int fd = memfd_create("plateverb-job", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+  if (fd < 0) return -1;
+  // The daemon maps the whole file and only accepts it with its size sealed
+  void* p = MAP_FAILED;
+  if (ftruncate(fd, (off_t)b->bytes) == 0 && b->bytes
+      && fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW) == 0) {
+    p = mmap(NULL, b->bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  if (p == MAP_FAILED) {
+    const int e = b->bytes ? errno : EINVAL;
+    close(fd);
+    errno = e;
+    return -1;
+  }
+  b->fd = fd;
+  b->in = (float*)p;
+  b->out_l = b->in + n_in;
+  b->out_r = b->out_l + n_out;
+  b->n_in = n_in;
+  b->n_out = n_out;
+  return 0;
+}
+
+void renderd_buffer_free(RenderdBuffer* b) {
+  if (b->in) munmap(b->in, b->bytes);
+  if (b->fd >= 0) close(b->fd);
+  memset(b, 0, sizeof(*b));
+  b->fd = -1;
+}
+
+int renderd_render(int sock, const RenderdBuffer* b, uint32_t n_in, uint32_t n_out, double sample_rate,
+                   const int32_t* ports, const float* values, uint32_t n_controls) {
+  static atomic_uint next_id;
+  if (n_in > b->n_in || n_out > b->n_out || n_out < n_in || n_controls > RENDERD_MAX_CONTROLS) {
+    errno = EINVAL;
+    return -1;
+  }
+  RenderdRequest req;
+  memset(&req, 0, sizeof(req));
+  req.magic = RENDERD_MAGIC;
+  req.id = atomic_fetch_add_explicit(&next_id, 1, memory_order_relaxed);
+  req.sample_rate = sample_rate;
+  req.buf_in = b->n_in;
+  req.buf_out = b->n_out;
+  req.n_in = n_in;
+  req.n_out = n_out;
+  req.n_controls = n_controls;
+  for (uint32_t i = 0; i < n_controls; ++i) {
+    req.port[i] = ports[i];
+    req.value[i] = values[i];
+  }
+
+  struct iovec iov = { &req, sizeof(req) };
+  union { char buf[CMSG_SPACE(sizeof(int))]; struct cmsghdr align; } ctl;
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = ctl.buf;
+  msg.msg_controllen = sizeof(ctl.buf);
+  struct cmsghdr* cm = CMSG_FIRSTHDR(&msg);
+  cm->cmsg_level = SOL_SOCKET;
+  cm->cmsg_type = SCM_RIGHTS;
+  cm->cmsg_len = CMSG_LEN(sizeof(int));
+  memcpy(CMSG_DATA(cm), &b->fd, sizeof(int));
+
+  ssize_t r;
+  do r = sendmsg(sock, &msg, MSG_NOSIGNAL); while (r < 0 && errno == EINTR);
+  if (r != (ssize_t)sizeof(req)) { if (r >= 0) errno = EIO; return -1; }
+
+  RenderdReply rep;
+  do r = recv(sock, &rep, sizeof(rep), 0); while (r < 0 && errno == EINTR);
+  if (r != (ssize_t)sizeof(rep) || rep.id != req.id) { if (r >= 0) errno = EPROTO; return -1; }
+  if (rep.status) { errno = rep.status; return -1; }
+  return 0;
+}
@@ -0,0 +1,71 @@
+// tools/renderd_client.h
+// Client library for renderd, the local PlateVerb render daemon.
+// Audio lives in a memfd shared with the daemon: a job sends a small
+// request plus the buffer's file descriptor, and the daemon renders
+// straight into the same pages. The daemon only takes a memfd whose size
+// is sealed (F_SEAL_SHRINK), as renderd_buffer_init() makes it.
+#ifndef RENDERD_CLIENT_H
+#define RENDERD_CLIENT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RENDERD_DEFAULT_SOCKET "/tmp/plateverb-renderd.sock"
+#define RENDERD_MAGIC          0x50565244u   // "PVRD"
+#define RENDERD_MAX_CONTROLS   16
+
+// ----- Wire format: one SOCK_SEQPACKET message each way -----
+// Buffer layout: in[buf_in], out_l[buf_out], out_r[buf_out] (float32).
+// A job reads n_in input frames and writes n_out output frames per
+// channel; frames past n_in render the tail with silent input.
+typedef struct {
+  uint32_t magic;
+  uint32_t id;
+  double sample_rate;
+  uint32_t buf_in;
+  uint32_t buf_out;
+  uint32_t n_in;
+  uint32_t n_out;
+  uint32_t n_controls;      // controls not listed keep their defaults
+  int32_t port[RENDERD_MAX_CONTROLS];
+  float value[RENDERD_MAX_CONTROLS];
+} RenderdRequest;           // carries the buffer fd (SCM_RIGHTS)
+
+typedef struct {
+  uint32_t id;
+  int32_t status;           // 0, or an errno value
+} RenderdReply;
+
+// ----- Client API -----
+typedef struct {
+  int fd;
+  float* in;
+  float* out_l;
+  float* out_r;
+  uint32_t n_in;
+  uint32_t n_out;
+  size_t bytes;
+} RenderdBuffer;
+
+// Connect to the daemon; returns a socket or -1 (errno set).
+int renderd_connect(const char* socket_path);
+
+// Shared buffer for jobs of up to n_in input and n_out output frames.
+// Reuse it across jobs: the daemon keeps it mapped for the connection.
+int renderd_buffer_init(RenderdBuffer* b, uint32_t n_in, uint32_t n_out);
+void renderd_buffer_free(RenderdBuffer* b);
+
+// Render b->in into b->out_l/out_r and wait for the result. n_in/n_out
+// may be smaller than the buffer. Returns 0, or -1 with errno set.
+int renderd_render(int sock, const RenderdBuffer* b, uint32_t n_in, uint32_t n_out, double sample_rate,
+                   const int32_t* ports, const float* values, uint32_t n_controls);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RENDERD_CLIENT_H
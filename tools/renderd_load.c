@@ -0,0 +1,149 @@
+// tools/renderd_load.c
+// Load test for renderd: C connections each submit a stream of small jobs
+// through their own shared buffer, then latency and throughput are shown.
+//
+//   renderd_load [-s SOCKET] [-c CONNS] [-n JOBS] [-f FRAMES] [-t TAIL] [-r RATE]
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "plateverb.h"
+#include "renderd_client.h"
+
+#define MAX_CONNS  256
+
+typedef struct {
+  const char* socket_path;
+  int jobs;
+  uint32_t frames;
+  uint32_t tail;
+  double rate;
+  unsigned seed;
+  double* latency;          // seconds, one per job
+  int failed;
+  int error;
+} Client;
+
+static double now_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+static void* client_main(void* arg) {
+  Client* cl = (Client*)arg;
+  RenderdBuffer b;
+  const int sock = renderd_connect(cl->socket_path);
+  if (sock < 0 || renderd_buffer_init(&b, cl->frames, cl->frames + cl->tail) < 0) {
+    cl->error = errno;
+    cl->failed = cl->jobs;
+    if (sock >= 0) close(sock);
+    return NULL;
+  }
+  const uint32_t last = cl->frames + cl->tail - 1;
+
+  for (int j = 0; j < cl->jobs; ++j) {
+    // A short burst of noise; every job gets its own decay and size
+    unsigned s = cl->seed + (unsigned)j * 2654435761u;
+    for (uint32_t i = 0; i < cl->frames; ++i) {
+      s = s * 1664525u + 1013904223u;
+      b.in[i] = (i < cl->frames / 4) ? (float)(int32_t)s * (0.5f / 2147483648.0f) : 0.0f;
+    }
+    const int32_t ports[3] = { PLATEVERB_DECAY_RT60, PLATEVERB_SIZE, PLATEVERB_MIX };
+    const float values[3] = { 0.5f + (float)(j % 16) * 0.5f, 0.5f + (float)(j % 7) * 0.25f, 1.0f };
+
+    const double t0 = now_seconds();
+    const int r = renderd_render(sock, &b, cl->frames, cl->frames + cl->tail, cl->rate, ports, values, 3);
+    cl->latency[j] = now_seconds() - t0;
+    if (r < 0) {
+      cl->error = errno;
+      ++cl->failed;
+      if (errno != EINVAL) break;
+    }
+    else if (!isfinite(b.out_l[last]) || !isfinite(b.out_r[last])) {
+      ++cl->failed;
+    }
+  }
+  renderd_buffer_free(&b);
+  close(sock);
+  return NULL;
+}
+
+static int cmp_double(const void* a, const void* b) {
+  const double x = *(const double*)a, y = *(const double*)b;
+  return (x > y) - (x < y);
+}
+
+static void usage(void) {
+  fprintf(stderr,
+    "usage: renderd_load [options]\n"
+    "  -s SOCKET  daemon socket (default " RENDERD_DEFAULT_SOCKET ")\n"
+    "  -c N       concurrent connections (default 4)\n"
+    "  -n N       jobs per connection (default 1000)\n"
+    "  -f N       input frames per job (default 2048)\n"
+    "  -t N       tail frames per job (default 2048)\n"
+    "  -r RATE    sample rate (default 48000)\n");
+}
+
+int main(int argc, char** argv) {
+  const char* path = RENDERD_DEFAULT_SOCKET;
+  int conns = 4, jobs = 1000;
+  long frames = 2048, tail = 2048;
+  double rate = 48000.0;
+  for (int i = 1; i < argc; ++i) {
+    const char* a = argv[i];
+    if (!strcmp(a, "-s") && i + 1 < argc) path = argv[++i];
+    else if (!strcmp(a, "-c") && i + 1 < argc) conns = atoi(argv[++i]);
+    else if (!strcmp(a, "-n") && i + 1 < argc) jobs = atoi(argv[++i]);
+    else if (!strcmp(a, "-f") && i + 1 < argc) frames = atol(argv[++i]);
+    else if (!strcmp(a, "-t") && i + 1 < argc) tail = atol(argv[++i]);
+    else if (!strcmp(a, "-r") && i + 1 < argc) rate = atof(argv[++i]);
+    else { usage(); return 2; }
+  }
+  if (conns < 1 || conns > MAX_CONNS || jobs < 1 || frames < 1 || tail < 0 || frames + tail > (1L << 26)) {
+    usage();
+    return 2;
+  }
+
+  Client cl[MAX_CONNS];
+  pthread_t th[MAX_CONNS];
+  const double t0 = now_seconds();
+  for (int c = 0; c < conns; ++c) {
+    cl[c] = (Client){ path, jobs, (uint32_t)frames, (uint32_t)tail, rate, 12345u + (unsigned)c * 977u,
+                      (double*)calloc((size_t)jobs, sizeof(double)), 0, 0 };
+    if (!cl[c].latency) return 1;
+    pthread_create(&th[c], NULL, client_main, &cl[c]);
+  }
+  int failed = 0, error = 0;
+  for (int c = 0; c < conns; ++c) {
+    pthread_join(th[c], NULL);
+    failed += cl[c].failed;
+    if (cl[c].error) error = cl[c].error;
+  }
+  const double wall = now_seconds() - t0;
+
+  const size_t total = (size_t)conns * (size_t)jobs;
+  double* all = (double*)malloc(total * sizeof(double));
+  if (!all) return 1;
+  for (int c = 0; c < conns; ++c) {
+    memcpy(all + (size_t)c * (size_t)jobs, cl[c].latency, (size_t)jobs * sizeof(double));
+    free(cl[c].latency);
+  }
+  qsort(all, total, sizeof(double), cmp_double);
+
+  const double audio = (double)total * (double)(frames + tail) / rate;
+  fprintf(stderr, "%zu job(s) over %d connection(s) in %.2f s: %.0f jobs/s, %.1fx realtime\n",
+          total, conns, wall, (double)total / wall, audio / wall);
+  fprintf(stderr, "latency ms: p50 %.3f  p99 %.3f  max %.3f\n",
+          1e3 * all[total / 2], 1e3 * all[(total * 99) / 100], 1e3 * all[total - 1]);
+  if (failed) fprintf(stderr, "%d job(s) failed (last error: %s)\n", failed, strerror(error));
+  free(all);
+  return failed ? 1 : 0;
+}